@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "appcaches.h"
+
+#include "vstgui/standalone/include/iapplication.h"
+#include "vstgui/standalone/include/icommondirectories.h"
+#include "vstgui/uidescription/cstream.h"
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+using namespace VSTGUI;
+using namespace VSTGUI::Standalone;
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+std::string getCacheFile (const char* name)
+{
+	auto folder = IApplication::instance ().getCommonDirectories ().get (
+	    CommonDirectoryLocation::AppCachesPath, "", true);
+	if (!folder)
+		return {};
+	return folder->getString () + name;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+std::string getCMakeCapabilitiesCacheFile ()
+{
+	return getCacheFile ("cmake_capabilities.json");
+}
+
+//------------------------------------------------------------------------
+std::string getTemplateCacheFile ()
+{
+	return getCacheFile ("compiled_templates.json");
+}
+
+//------------------------------------------------------------------------
+std::string getSDKPrebuiltCacheFolder ()
+{
+	auto folder = IApplication::instance ().getCommonDirectories ().get (
+	    CommonDirectoryLocation::AppCachesPath, "vst3sdk", true);
+	if (!folder)
+		return {};
+	auto path = folder->getString ();
+	unixfyPath (path);
+	while (path.size () > 1 && path.back () == '/')
+		path.pop_back ();
+	return path;
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
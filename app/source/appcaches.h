@@ -0,0 +1,25 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include <string>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** The files in the caches folder of the application, shared by the window and the batch mode.
+ *	All functions return an empty string if the caches folder could not be created.
+ */
+std::string getCMakeCapabilitiesCacheFile ();
+std::string getTemplateCacheFile ();
+/** the folder of the SDK builds shared by all projects, with forward slashes */
+std::string getSDKPrebuiltCacheFolder ();
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
@@ -2,6 +2,7 @@
 // Flags       : clang-format SMTGSequencer
 
 #include "application.h"
+#include "batchgenerator.h"
 #include "controller.h"
 #include "version.h"
 
@@ -10,6 +11,8 @@
 #include "vstgui/standalone/include/iapplication.h"
 #include "vstgui/standalone/include/iuidescwindow.h"
 
+#include <cstdlib>
+
 //------------------------------------------------------------------------
 namespace Steinberg {
 namespace Vst {
@@ -28,6 +31,9 @@ Application::Application ()
 //------------------------------------------------------------------------
 void Application::finishLaunching ()
 {
+	if (runBatch ())
+		return;
+
 	auto controller = std::make_shared<Controller> ();
 
 	UIDesc::Config config;
@@ -49,12 +55,45 @@ void Application::finishLaunching ()
 	}
 }
 
+//------------------------------------------------------------------------
+bool Application::runBatch ()
+{
+	// VST3_Project_Generator --batch <manifest.json> [--report <report.json>]
+	const auto& args = IApplication::instance ().getCommandLineArguments ();
+	std::string manifestPath;
+	std::string reportPath;
+	for (size_t i = 0; i + 1 < args.size (); ++i)
+	{
+		if (args[i] == "--batch")
+			manifestPath = args[++i].getString ();
+		else if (args[i] == "--report")
+			reportPath = args[++i].getString ();
+	}
+	if (manifestPath.empty ())
+		return false;
+
+	batchGenerator = BatchGenerator::create (ProcessExecutor::create ());
+	batchGenerator->run (manifestPath, reportPath, [this] (bool success) {
+		batchFailed = !success;
+		IApplication::instance ().quit ();
+	});
+	return true;
+}
+
 //------------------------------------------------------------------------
 void Application::onClosed (const IWindow& window)
 {
 	IApplication::instance ().quit ();
 }
 
+//------------------------------------------------------------------------
+void Application::onQuit ()
+{
+	// the standalone library always exits with 0, scripts must be able to detect a failed batch
+	if (batchFailed)
+		std::exit (EXIT_FAILURE);
+}
+
 //------------------------------------------------------------------------
 static Standalone::Application::Init gAppDelegate (std::make_unique<Application> ());
 
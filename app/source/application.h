@@ -5,12 +5,15 @@
 
 #include "vstgui/standalone/include/helpers/appdelegate.h"
 #include "vstgui/standalone/include/helpers/windowlistener.h"
+#include <memory>
 
 //------------------------------------------------------------------------
 namespace Steinberg {
 namespace Vst {
 namespace ProjectCreator {
 
+class BatchGenerator;
+
 //------------------------------------------------------------------------
 class Application : public VSTGUI::Standalone::Application::DelegateAdapter,
                     public VSTGUI::Standalone::WindowListenerAdapter
@@ -22,6 +25,13 @@ public:
 
 	void finishLaunching () override;
 	void onClosed (const IWindow& window) override;
+	void onQuit () override;
+
+private:
+	bool runBatch ();
+
+	std::shared_ptr<BatchGenerator> batchGenerator;
+	bool batchFailed {false};
 };
 
 //------------------------------------------------------------------------
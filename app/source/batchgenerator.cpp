@@ -0,0 +1,666 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "batchgenerator.h"
+#include "appcaches.h"
+#include "cmakebuildtree.h"
+#include "cmakediscovery.h"
+#include "controller.h"
+#include "filesystem.h"
+#include "include/rapidjson/document.h"
+#include "include/rapidjson/prettywriter.h"
+#include "include/rapidjson/schema.h"
+#include "include/rapidjson/stringbuffer.h"
+#include "processpipeline.h"
+#include "templateengine.h"
+
+#include "vstgui/standalone/include/helpers/preferences.h"
+#include "vstgui/standalone/include/iapplication.h"
+#include "vstgui/standalone/include/iasync.h"
+#include "vstgui/standalone/include/icommondirectories.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+using namespace VSTGUI;
+using namespace VSTGUI::Standalone;
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+constexpr auto ManifestSchema = R"({
+	"type": "object",
+	"required": ["projects"],
+	"additionalProperties": false,
+	"properties": {
+		"cmake": {"type": "string", "minLength": 1},
+		"cmakeGenerator": {"type": "string", "minLength": 1},
+		"cmakePlatform": {"type": "string"},
+		"sdk": {"type": "string", "minLength": 1},
+		"output": {"type": "string", "minLength": 1},
+		"vendor": {"$ref": "#/definitions/vendor"},
+		"deterministicUUIDs": {"type": "boolean"},
+		"linkCopiedFiles": {"type": "boolean"},
+		"sharedSDKBuild": {"type": "boolean"},
+		"compilerCache": {"type": "boolean"},
+		"build": {"type": "boolean"},
+		"precompiledHeaders": {"type": "boolean"},
+		"unityBuild": {"type": "boolean"},
+		"projects": {"type": "array", "minItems": 1, "items": {"$ref": "#/definitions/project"}}
+	},
+	"definitions": {
+		"vendor": {
+			"type": "object",
+			"additionalProperties": false,
+			"properties": {
+				"name": {"type": "string"},
+				"homepage": {"type": "string"},
+				"email": {"type": "string"},
+				"namespace": {"type": "string"}
+			}
+		},
+		"project": {
+			"type": "object",
+			"required": ["name", "bundleID"],
+			"additionalProperties": false,
+			"properties": {
+				"name": {"type": "string", "minLength": 1},
+				"bundleID": {"type": "string", "minLength": 1},
+				"type": {"enum": ["Fx", "Instrument"]},
+				"className": {"type": "string"},
+				"filenamePrefix": {"type": "string"},
+				"vstgui": {"type": "boolean"},
+				"macOSDeploymentTarget": {"type": "string"},
+				"sdk": {"type": "string", "minLength": 1},
+				"output": {"type": "string", "minLength": 1},
+				"vendor": {"$ref": "#/definitions/vendor"},
+				"configure": {"type": "boolean"},
+				"build": {"type": "boolean"},
+				"deterministicUUIDs": {"type": "boolean"},
+				"uuidSeed": {"type": "string", "minLength": 1},
+				"precompiledHeaders": {"type": "boolean"},
+				"unityBuild": {"type": "boolean"}
+			}
+		}
+	}
+})";
+
+//------------------------------------------------------------------------
+double secondsSince (std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+}
+
+//------------------------------------------------------------------------
+template <typename Value>
+void readString (const Value& object, const char* key, std::string& str)
+{
+	if (object.HasMember (key))
+		str = object[key].GetString ();
+}
+
+//------------------------------------------------------------------------
+template <typename Value>
+void readVendor (const Value& object, ProjectSettings& settings)
+{
+	if (!object.HasMember ("vendor"))
+		return;
+	const auto& vendor = object["vendor"];
+	readString (vendor, "name", settings.vendorName);
+	readString (vendor, "homepage", settings.vendorHomepage);
+	readString (vendor, "email", settings.vendorEMail);
+	readString (vendor, "namespace", settings.vendorNamespace);
+}
+
+//------------------------------------------------------------------------
+/** CMake expects forward slashes in the paths of the generated files */
+void makeUnixPath (std::string& path)
+{
+	std::replace (path.begin (), path.end (), '\\', '/');
+	while (path.size () > 1 && path.back () == '/')
+		path.pop_back ();
+}
+
+//------------------------------------------------------------------------
+std::string getPreference (const char* key)
+{
+	Preferences prefs;
+	if (auto value = prefs.get (key))
+		return value->getString ();
+	return {};
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+std::shared_ptr<BatchGenerator> BatchGenerator::create (
+    const std::shared_ptr<ProcessExecutor>& executor)
+{
+	auto generator = std::make_shared<BatchGenerator> ();
+	generator->executor = executor;
+	return generator;
+}
+
+//------------------------------------------------------------------------
+const char* BatchGenerator::getManifestSchema ()
+{
+	return ManifestSchema;
+}
+
+//------------------------------------------------------------------------
+void BatchGenerator::run (const std::string& manifestPath, const std::string& report,
+                          CompletionFunction&& completionFunc)
+{
+	completion = std::move (completionFunc);
+	reportPath = report;
+	startTime = Clock::now ();
+
+	const auto& directories = IApplication::instance ().getCommonDirectories ();
+	if (auto resources = directories.get (CommonDirectoryLocation::AppResourcesPath))
+		scriptDir = resources->getString ();
+	templateCacheFile = getTemplateCacheFile ();
+
+	if (!loadManifest (manifestPath))
+	{
+		finish (false);
+		return;
+	}
+	findCMake ();
+}
+
+//------------------------------------------------------------------------
+bool BatchGenerator::loadManifest (const std::string& manifestPath)
+{
+	using namespace rapidjson;
+
+	auto json = readFile (manifestPath);
+	if (!json)
+	{
+		printError ("Could not read the manifest " + manifestPath);
+		return false;
+	}
+
+	Document doc;
+	doc.Parse (json->data (), json->size ());
+	if (doc.HasParseError ())
+	{
+		printError ("The manifest is not valid JSON (offset " +
+		            std::to_string (doc.GetErrorOffset ()) + ")");
+		return false;
+	}
+
+	Document schemaDoc;
+	schemaDoc.Parse (ManifestSchema);
+	assert (!schemaDoc.HasParseError ());
+	SchemaDocument schema (schemaDoc);
+	SchemaValidator validator (schema);
+	if (!doc.Accept (validator))
+	{
+		StringBuffer documentPointer;
+		validator.GetInvalidDocumentPointer ().StringifyUriFragment (documentPointer);
+		printError (std::string ("The manifest does not match the schema at ") +
+		            documentPointer.GetString () + " (" + validator.GetInvalidSchemaKeyword () +
+		            ")");
+		return false;
+	}
+
+	ProjectSettings defaults;
+	defaults.sdkPath = getPreference (valueIdVSTSDKPath);
+	defaults.outputPath = getPreference (valueIdPluginPath);
+	defaults.vendorName = getPreference (valueIdVendorName);
+	defaults.vendorHomepage = getPreference (valueIdVendorURL);
+	defaults.vendorEMail = getPreference (valueIdVendorEMail);
+	defaults.vendorNamespace = getPreference (valueIdVendorNamespace);
+	readString (doc, "sdk", defaults.sdkPath);
+	readString (doc, "output", defaults.outputPath);
+	readVendor (doc, defaults);
+	if (doc.HasMember ("deterministicUUIDs"))
+		defaults.deterministicUUIDs = doc["deterministicUUIDs"].GetBool ();
+	if (doc.HasMember ("precompiledHeaders"))
+		defaults.precompiledHeaders = doc["precompiledHeaders"].GetBool ();
+	if (doc.HasMember ("unityBuild"))
+		defaults.unityBuild = doc["unityBuild"].GetBool ();
+	if (doc.HasMember ("sharedSDKBuild") && doc["sharedSDKBuild"].GetBool ())
+		defaults.sdkPrebuiltCachePath = getSDKPrebuiltCacheFolder ();
+	if (doc.HasMember ("compilerCache") && doc["compilerCache"].GetBool ())
+	{
+		defaults.compilerLauncher = findCompilerLauncher ();
+		makeUnixPath (defaults.compilerLauncher);
+	}
+
+	cmakePath = getPreference (valueIdCMakePath);
+	readString (doc, "cmake", cmakePath);
+	readString (doc, "cmakeGenerator", cmakeGenerator);
+	readString (doc, "cmakePlatform", cmakePlatform);
+	if (doc.HasMember ("linkCopiedFiles"))
+		linkCopiedFiles = doc["linkCopiedFiles"].GetBool ();
+	auto buildProjects = false;
+	if (doc.HasMember ("build"))
+		buildProjects = doc["build"].GetBool ();
+
+	for (const auto& entry : doc["projects"].GetArray ())
+	{
+		Project project;
+		auto& settings = project.settings;
+		settings = defaults;
+		readString (entry, "name", settings.pluginName);
+		readString (entry, "bundleID", settings.bundleID);
+		readString (entry, "type", settings.pluginCategory);
+		readString (entry, "className", settings.className);
+		readString (entry, "filenamePrefix", settings.filenamePrefix);
+		readString (entry, "macOSDeploymentTarget", settings.macOSDeploymentTarget);
+		readString (entry, "sdk", settings.sdkPath);
+		readString (entry, "output", settings.outputPath);
+		readVendor (entry, settings);
+		readString (entry, "uuidSeed", settings.uuidSeed);
+		if (entry.HasMember ("deterministicUUIDs"))
+			settings.deterministicUUIDs = entry["deterministicUUIDs"].GetBool ();
+		if (entry.HasMember ("vstgui"))
+			settings.useVSTGUI = entry["vstgui"].GetBool ();
+		if (entry.HasMember ("precompiledHeaders"))
+			settings.precompiledHeaders = entry["precompiledHeaders"].GetBool ();
+		if (entry.HasMember ("unityBuild"))
+			settings.unityBuild = entry["unityBuild"].GetBool ();
+		project.configure = !cmakeGenerator.empty ();
+		if (entry.HasMember ("configure"))
+			project.configure = entry["configure"].GetBool ();
+		project.build = project.configure && buildProjects;
+		if (entry.HasMember ("build"))
+			project.build = project.configure && entry["build"].GetBool ();
+
+		makeValidCppName (settings.className);
+		makeValidCppName (settings.vendorNamespace, true);
+		makeUnixPath (settings.sdkPath);
+		makeUnixPath (settings.outputPath);
+		if (settings.sdkPath.empty () || settings.outputPath.empty ())
+		{
+			printError ("No SDK or output path for " + settings.pluginName);
+			return false;
+		}
+		if (project.configure && cmakeGenerator.empty ())
+		{
+			printError ("No cmakeGenerator to configure " + settings.pluginName);
+			return false;
+		}
+		projects.emplace_back (std::move (project));
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+void BatchGenerator::findCMake ()
+{
+	auto needsCMake = std::any_of (projects.begin (), projects.end (),
+	                               [] (const auto& project) { return project.configure; });
+	if (!needsCMake)
+	{
+		runProjects ();
+		return;
+	}
+	if (!cmakePath.empty ())
+	{
+		queryCapabilities ();
+		return;
+	}
+	auto capabilitiesStart = Clock::now ();
+	auto discovery = CMakeDiscovery::create (executor);
+	auto self = shared_from_this ();
+	discovery->run ([self, discovery, capabilitiesStart] (auto&& installations) {
+		if (installations.empty ())
+		{
+			self->printError ("Could not find CMake");
+			self->finish (false);
+			return;
+		}
+		self->cmakePath = installations.front ().path;
+		self->capabilitiesSeconds = secondsSince (capabilitiesStart);
+		self->onCapabilities (std::move (installations.front ().capabilities), false);
+	});
+}
+
+//------------------------------------------------------------------------
+void BatchGenerator::queryCapabilities ()
+{
+	auto capabilitiesStart = Clock::now ();
+	auto cacheFile = getCMakeCapabilitiesCacheFile ();
+	if (auto cached = loadCMakeCapabilitiesCache (cacheFile, cmakePath))
+	{
+		capabilitiesSeconds = secondsSince (capabilitiesStart);
+		onCapabilities (std::move (*cached), true);
+		return;
+	}
+
+	ProcessExecutor::Job job;
+	job.path = cmakePath;
+	job.arguments.add ("-E");
+	job.arguments.add ("capabilities");
+	auto parser = std::make_shared<CMakeCapabilitiesParser> ();
+	auto self = shared_from_this ();
+	job.callback = [self, parser, cacheFile, capabilitiesStart] (Process::CallbackParams& p) {
+		parser->append (p.buffer.data (), p.buffer.size ());
+		if (!p.isEOF)
+			return;
+		self->capabilitiesSeconds = secondsSince (capabilitiesStart);
+		if (auto result = parser->finish ())
+		{
+			storeCMakeCapabilitiesCache (cacheFile, self->cmakePath, *result);
+			self->onCapabilities (std::move (*result), false);
+		}
+		else
+		{
+			self->printError ("Could not query the capabilities of " + self->cmakePath);
+			self->finish (false);
+		}
+	};
+	executor->submit (std::move (job));
+}
+
+//------------------------------------------------------------------------
+void BatchGenerator::onCapabilities (CMakeCapabilites&& result, bool cached)
+{
+	capabilities = std::move (result);
+	capabilitiesCached = cached;
+
+	auto generator = std::find_if (
+	    capabilities.generators.begin (), capabilities.generators.end (),
+	    [&] (const auto& gen) { return gen.name.getString () == cmakeGenerator; });
+	if (generator == capabilities.generators.end ())
+	{
+		printError ("CMake " + cmakePath + " does not support the generator " + cmakeGenerator);
+		finish (false);
+		return;
+	}
+	if (!cmakePlatform.empty () &&
+	    std::none_of (generator->platforms.begin (), generator->platforms.end (),
+	                  [&] (const auto& platform) { return platform.getString () == cmakePlatform; }))
+	{
+		printError ("The generator " + cmakeGenerator + " does not support the platform " +
+		            cmakePlatform);
+		finish (false);
+		return;
+	}
+	runProjects ();
+}
+
+//------------------------------------------------------------------------
+void BatchGenerator::runProjects ()
+{
+	auto self = shared_from_this ();
+	auto pipeline = ProcessPipeline::create (executor);
+	// the projects are built at the same time, so they share the processor cores
+	auto numBuilds = static_cast<size_t> (std::count_if (
+	    projects.begin (), projects.end (), [] (const auto& project) { return project.build; }));
+	auto buildParallel = std::max<size_t> (
+	    std::max (std::thread::hardware_concurrency (), 1u) / std::max<size_t> (numBuilds, 1), 1);
+	for (size_t index = 0; index < projects.size (); ++index)
+	{
+		const auto& settings = projects[index].settings;
+		// like in the window, the script is only run if the native generator fails
+		auto definitions = makeGeneratorDefinitions (settings);
+		ProcessPipeline::StepFunction fallback;
+		if (!cmakePath.empty ())
+		{
+			Process::ArgumentList fallbackArgs;
+			for (const auto& definition : definitions)
+				fallbackArgs.add ("-D" + definition.first + "=" + definition.second);
+			fallbackArgs.add ("-P");
+			fallbackArgs.addPath (scriptDir + "GenerateVST3Plugin.cmake");
+			auto cmake = cmakePath;
+			fallback = pipeline->makeProcessStepFunction ([self, index, cmake, fallbackArgs] () {
+				ProcessExecutor::Job job;
+				job.path = cmake;
+				job.arguments = fallbackArgs;
+				job.callback = [self, index] (Process::CallbackParams& p) {
+					auto& log = self->projects[index].log;
+					log.append (p.buffer.data (), p.buffer.size ());
+					log.append (p.errorBuffer.data (), p.errorBuffer.size ());
+				};
+				return job;
+			});
+		}
+		auto generateStep = pipeline->addStep (
+		    "generate " + settings.pluginName,
+		    [self, index, definitions, fallback] (ProcessPipeline::DoneFunction&& done) {
+			    auto stepStart = Clock::now ();
+			    GeneratorOptions options;
+			    options.cacheFile = self->templateCacheFile;
+			    options.incremental = true;
+			    options.linkCopiedFiles = self->linkCopiedFiles;
+			    auto scriptDir = self->scriptDir;
+			    Async::schedule (Async::backgroundQueue (), [=] () {
+				    std::string log;
+				    auto variables = makeTemplateVariables (definitions, scriptDir);
+				    auto success = generateProject (variables, options, log);
+				    Async::schedule (Async::mainQueue (), [=] () {
+					    auto& project = self->projects[index];
+					    project.log = log;
+					    auto onGenerated = [self, index, stepStart, done] (bool success) {
+						    auto& project = self->projects[index];
+						    project.generated = success;
+						    project.generateSeconds = secondsSince (stepStart);
+						    auto doneFunc = done;
+						    doneFunc (success);
+					    };
+					    if (success || !fallback)
+					    {
+						    onGenerated (success);
+						    return;
+					    }
+					    project.log += "\nFalling back to GenerateVST3Plugin.cmake\n";
+					    fallback (std::move (onGenerated));
+				    });
+			    });
+		    });
+		if (!projects[index].configure)
+			continue;
+
+		auto projectPath = settings.outputPath + "/" + settings.pluginName;
+		auto buildDir = projectPath + "/build";
+		Process::ArgumentList args;
+		args.add ("-G");
+		args.addPath (cmakeGenerator);
+		if (!cmakePlatform.empty ())
+		{
+			args.add ("-A");
+			args.add (cmakePlatform);
+		}
+		args.add ("-S");
+		args.addPath (projectPath);
+		args.add ("-B");
+		args.addPath (buildDir);
+		for (const auto& definition : makeConfigureDefinitions (settings))
+			args.addDefinition (definition.first, definition.second);
+		auto cmake = cmakePath;
+		auto generator = cmakeGenerator;
+		auto platform = cmakePlatform;
+		auto configure = pipeline->makeProcessStepFunction ([=] () {
+			// an existing build folder keeps its cache and objects if cmake can reuse it
+			if (!canReuseCMakeBuildTree (buildDir, projectPath, generator, platform))
+				removeDirectoryRecursive (buildDir);
+			// the output of cmake is written to a log file in the build folder
+			createDirectories (buildDir);
+			auto log = std::make_shared<std::ofstream> (buildDir + "/project_generator.log",
+			                                            std::ios::out | std::ios::binary);
+			ProcessExecutor::Job job;
+			job.path = cmake;
+			job.arguments = args;
+			job.callback = [log] (Process::CallbackParams& p) {
+				log->write (p.buffer.data (), p.buffer.size ());
+				log->write (p.errorBuffer.data (), p.errorBuffer.size ());
+			};
+			return job;
+		});
+		auto configureStep = pipeline->addStep (
+		    "configure " + settings.pluginName,
+		    [self, index, configure] (ProcessPipeline::DoneFunction&& done) {
+			    auto stepStart = Clock::now ();
+			    configure ([self, index, stepStart, done] (bool success) {
+				    auto& project = self->projects[index];
+				    project.configured = success;
+				    project.configureSeconds = secondsSince (stepStart);
+				    done (success);
+			    });
+		    },
+		    {generateStep});
+		if (!projects[index].build)
+			continue;
+
+		Process::ArgumentList buildArgs;
+		buildArgs.add ("--build");
+		buildArgs.addPath (buildDir);
+		buildArgs.add ("--parallel");
+		buildArgs.add (std::to_string (buildParallel));
+		auto parser = std::make_shared<BuildProgressParser> ();
+		auto build = pipeline->makeProcessStepFunction ([=] () {
+			// appended to the output of the configure step
+			auto log = std::make_shared<std::ofstream> (buildDir + "/project_generator.log",
+			                                            std::ios::out | std::ios::binary |
+			                                                std::ios::app);
+			ProcessExecutor::Job job;
+			job.path = cmake;
+			job.arguments = buildArgs;
+			job.callback = [log, parser] (Process::CallbackParams& p) {
+				parser->append (p.buffer.data (), p.buffer.size ());
+				log->write (p.buffer.data (), p.buffer.size ());
+				log->write (p.errorBuffer.data (), p.errorBuffer.size ());
+				if (p.isEOF)
+					parser->finish ();
+			};
+			return job;
+		});
+		pipeline->addStep ("build " + settings.pluginName,
+		                   [self, index, build, parser] (ProcessPipeline::DoneFunction&& done) {
+			                   auto stepStart = Clock::now ();
+			                   build ([self, index, stepStart, parser, done] (bool success) {
+				                   auto& project = self->projects[index];
+				                   project.built = success;
+				                   project.buildSeconds = secondsSince (stepStart);
+				                   project.targetTimes = parser->getTargetTimes ();
+				                   done (success);
+			                   });
+		                   },
+		                   {configureStep});
+	}
+	pipeline->run ([self, pipeline] (bool success) { self->finish (success); });
+}
+
+//------------------------------------------------------------------------
+void BatchGenerator::finish (bool success)
+{
+	auto report = makeReport (success);
+	if (reportPath.empty () || !writeFile (reportPath, report))
+	{
+		fwrite (report.data (), 1, report.size (), stdout);
+		fflush (stdout);
+	}
+	auto completionFunc = std::move (completion);
+	if (completionFunc)
+		completionFunc (success);
+}
+
+//------------------------------------------------------------------------
+std::string BatchGenerator::makeReport (bool success) const
+{
+	using namespace rapidjson;
+
+	StringBuffer buffer;
+	PrettyWriter<StringBuffer> writer (buffer);
+	writer.StartObject ();
+	writer.Key ("success");
+	writer.Bool (success);
+	writer.Key ("totalSeconds");
+	writer.Double (secondsSince (startTime));
+	writer.Key ("errors");
+	writer.StartArray ();
+	for (const auto& error : errors)
+		writer.String (error.data (), static_cast<SizeType> (error.size ()));
+	writer.EndArray ();
+	if (!cmakePath.empty () && capabilities.versionMajor > 0)
+	{
+		auto version = std::to_string (capabilities.versionMajor) + "." +
+		               std::to_string (capabilities.versionMinor) + "." +
+		               std::to_string (capabilities.versionPatch);
+		writer.Key ("cmake");
+		writer.StartObject ();
+		writer.Key ("path");
+		writer.String (cmakePath.data (), static_cast<SizeType> (cmakePath.size ()));
+		writer.Key ("version");
+		writer.String (version.data (), static_cast<SizeType> (version.size ()));
+		writer.Key ("capabilitiesCached");
+		writer.Bool (capabilitiesCached);
+		writer.Key ("capabilitiesSeconds");
+		writer.Double (capabilitiesSeconds);
+		writer.EndObject ();
+	}
+	writer.Key ("projects");
+	writer.StartArray ();
+	for (const auto& project : projects)
+	{
+		const auto& settings = project.settings;
+		auto path = settings.outputPath + "/" + settings.pluginName;
+		writer.StartObject ();
+		writer.Key ("name");
+		writer.String (settings.pluginName.data (),
+		               static_cast<SizeType> (settings.pluginName.size ()));
+		writer.Key ("path");
+		writer.String (path.data (), static_cast<SizeType> (path.size ()));
+		writer.Key ("generated");
+		writer.Bool (project.generated);
+		writer.Key ("generateSeconds");
+		writer.Double (project.generateSeconds);
+		if (project.configure)
+		{
+			writer.Key ("configured");
+			writer.Bool (project.configured);
+			writer.Key ("configureSeconds");
+			writer.Double (project.configureSeconds);
+		}
+		if (project.build)
+		{
+			writer.Key ("built");
+			writer.Bool (project.built);
+			writer.Key ("buildSeconds");
+			writer.Double (project.buildSeconds);
+			writer.Key ("targets");
+			writer.StartArray ();
+			for (const auto& target : project.targetTimes)
+			{
+				writer.StartObject ();
+				writer.Key ("name");
+				writer.String (target.name.data (), static_cast<SizeType> (target.name.size ()));
+				writer.Key ("seconds");
+				writer.Double (target.seconds);
+				writer.EndObject ();
+			}
+			writer.EndArray ();
+		}
+		writer.Key ("log");
+		writer.String (project.log.data (), static_cast<SizeType> (project.log.size ()));
+		writer.EndObject ();
+	}
+	writer.EndArray ();
+	writer.EndObject ();
+	return std::string (buffer.GetString (), buffer.GetSize ()) + "\n";
+}
+
+//------------------------------------------------------------------------
+void BatchGenerator::printError (const std::string& message)
+{
+	fprintf (stderr, "%s\n", message.data ());
+	errors.emplace_back (message);
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
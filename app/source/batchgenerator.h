@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "buildprogress.h"
+#include "cmakecapabilities.h"
+#include "processexecutor.h"
+#include "projectsettings.h"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** Generates the projects described in a JSON manifest without user interface.
+ *
+ *	The manifest is validated against a JSON schema before anything is generated. The CMake
+ *	capabilities are queried only once for all projects, the projects are generated with the
+ *	native generator and optionally configured with the given CMake generator and built. Like in
+ *	the window, GenerateVST3Plugin.cmake is run if the native generator fails and a CMake
+ *	executable is known. Finally a JSON report with the timing of each project is written.
+ *
+ *	Must be started on the main thread, the completion is called there.
+ */
+class BatchGenerator : public std::enable_shared_from_this<BatchGenerator>
+{
+public:
+	using CompletionFunction = std::function<void (bool success)>;
+
+	static std::shared_ptr<BatchGenerator> create (
+	    const std::shared_ptr<ProcessExecutor>& executor);
+
+	/** the report is written to reportPath, or to stdout if it is empty */
+	void run (const std::string& manifestPath, const std::string& reportPath,
+	          CompletionFunction&& completion);
+
+	/** the JSON schema of the manifest */
+	static const char* getManifestSchema ();
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Project
+	{
+		ProjectSettings settings;
+		bool configure {false};
+		bool build {false};
+
+		bool generated {false};
+		bool configured {false};
+		bool built {false};
+		double generateSeconds {0.};
+		double configureSeconds {0.};
+		double buildSeconds {0.};
+		std::vector<BuildProgressParser::TargetTime> targetTimes;
+		std::string log;
+	};
+
+	bool loadManifest (const std::string& manifestPath);
+	void findCMake ();
+	void queryCapabilities ();
+	void onCapabilities (CMakeCapabilites&& capabilities, bool cached);
+	void runProjects ();
+	void finish (bool success);
+	std::string makeReport (bool success) const;
+	void printError (const std::string& message);
+
+	std::shared_ptr<ProcessExecutor> executor;
+	CompletionFunction completion;
+	std::string reportPath;
+	std::string scriptDir;
+	std::string templateCacheFile;
+	std::vector<std::string> errors;
+	bool linkCopiedFiles {false};
+
+	std::string cmakePath;
+	std::string cmakeGenerator;
+	std::string cmakePlatform;
+	CMakeCapabilites capabilities;
+	bool capabilitiesCached {false};
+	double capabilitiesSeconds {0.};
+
+	std::vector<Project> projects;
+	Clock::time_point startTime;
+};
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
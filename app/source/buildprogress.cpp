@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "buildprogress.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+/** "[k/N] ..." or "[ p%] ...", negative if the line has no progress prefix */
+double parseProgress (const std::string& line)
+{
+	auto start = line.find_first_not_of (' ');
+	if (start == std::string::npos || line[start] != '[')
+		return -1.;
+	auto end = line.find (']', start);
+	if (end == std::string::npos)
+		return -1.;
+	auto content = line.substr (start + 1, end - start - 1);
+	char* parseEnd = nullptr;
+	auto value = std::strtod (content.data (), &parseEnd);
+	if (parseEnd == content.data ())
+		return -1.;
+	if (*parseEnd == '%')
+		return value / 100.;
+	if (*parseEnd != '/')
+		return -1.;
+	auto total = std::strtod (parseEnd + 1, &parseEnd);
+	if (*parseEnd != 0 || total <= 0.)
+		return -1.;
+	return value / total;
+}
+
+//------------------------------------------------------------------------
+/** the text between prefix and suffix, empty if the line does not contain both */
+std::string extract (const std::string& line, const char* prefix, const char* suffix)
+{
+	auto start = line.find (prefix);
+	if (start == std::string::npos)
+		return {};
+	start += std::char_traits<char>::length (prefix);
+	auto end = line.find (suffix, start);
+	if (end == std::string::npos)
+		return {};
+	return line.substr (start, end - start);
+}
+
+//------------------------------------------------------------------------
+std::string parseTargetName (const std::string& line)
+{
+	// Make: "[ 50%] Built target base"
+	static const std::string builtTarget = "Built target ";
+	auto pos = line.find (builtTarget);
+	if (pos != std::string::npos)
+		return line.substr (pos + builtTarget.size ());
+	// object files of all generators: ".../CMakeFiles/base.dir/source/fobject.cpp.o"
+	auto name = extract (line, "CMakeFiles/", ".dir/");
+	if (name.empty ())
+		name = extract (line, "CMakeFiles\\", ".dir\\");
+	if (!name.empty () && name.find_first_of ("/\\ ") == std::string::npos)
+		return name;
+	// MSBuild: "  base.vcxproj -> C:\build\lib\Debug\base.lib"
+	name = extract (line, "", ".vcxproj -> ");
+	if (!name.empty ())
+	{
+		name.erase (0, name.find_first_not_of (' '));
+		return name;
+	}
+	// Xcode: "=== BUILD TARGET base OF PROJECT vstsdk WITH CONFIGURATION Debug ==="
+	return extract (line, "=== BUILD TARGET ", " OF PROJECT ");
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+void BuildProgressParser::append (const char* data, size_t size, Clock::time_point now)
+{
+	auto end = data + size;
+	while (data != end)
+	{
+		auto lineEnd = std::find (data, end, '\n');
+		partialLine.append (data, lineEnd);
+		if (lineEnd == end)
+			break;
+		if (!partialLine.empty () && partialLine.back () == '\r')
+			partialLine.pop_back ();
+		parseLine (partialLine, now);
+		partialLine.clear ();
+		data = lineEnd + 1;
+	}
+}
+
+//------------------------------------------------------------------------
+void BuildProgressParser::finish (Clock::time_point now)
+{
+	if (!partialLine.empty ())
+	{
+		parseLine (partialLine, now);
+		partialLine.clear ();
+	}
+	endOpenTargets (now);
+}
+
+//------------------------------------------------------------------------
+void BuildProgressParser::parseLine (const std::string& line, Clock::time_point now)
+{
+	endOpenTargets (now);
+	auto lineProgress = parseProgress (line);
+	if (lineProgress >= 0.)
+		progress = std::min (lineProgress, 1.);
+	auto name = parseTargetName (line);
+	if (!name.empty ())
+		onTargetOutput (std::move (name), now);
+}
+
+//------------------------------------------------------------------------
+void BuildProgressParser::onTargetOutput (std::string&& name, Clock::time_point now)
+{
+	auto it = std::find_if (targets.begin (), targets.end (),
+	                        [&] (const auto& target) { return target.name == name; });
+	if (it == targets.end ())
+	{
+		Target target;
+		target.name = std::move (name);
+		target.firstOutput = now;
+		it = targets.emplace (targets.end (), std::move (target));
+	}
+	it->end = now;
+	auto index = static_cast<size_t> (std::distance (targets.begin (), it));
+	if (std::find (openTargets.begin (), openTargets.end (), index) == openTargets.end ())
+		openTargets.emplace_back (index);
+}
+
+//------------------------------------------------------------------------
+void BuildProgressParser::endOpenTargets (Clock::time_point now)
+{
+	for (auto index : openTargets)
+		targets[index].end = now;
+	openTargets.clear ();
+}
+
+//------------------------------------------------------------------------
+auto BuildProgressParser::getTargetTimes () const -> std::vector<TargetTime>
+{
+	std::vector<TargetTime> result;
+	result.reserve (targets.size ());
+	for (const auto& target : targets)
+	{
+		TargetTime time;
+		time.name = target.name;
+		time.seconds = std::chrono::duration<double> (target.end - target.firstOutput).count ();
+		result.emplace_back (std::move (time));
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
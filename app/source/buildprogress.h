@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** Parses the output of "cmake --build" while it arrives.
+ *
+ *	The progress is taken from the "[k/N]" prefix of Ninja and the "[ p%]" prefix of the Makefile
+ *	generators. The build tools print a line when they start a step, so a target counts as being
+ *	built from its first output line until the line following its last one, or the end of the
+ *	build. With parallel builds this is an approximation. The name of a target is taken from the
+ *	"CMakeFiles/<target>.dir" folder of its object files and from the lines which Make, MSBuild
+ *	and Xcode print when they build a target.
+ */
+class BuildProgressParser
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct TargetTime
+	{
+		std::string name;
+		double seconds {0.};
+	};
+
+	void append (const char* data, size_t size, Clock::time_point now = Clock::now ());
+	/** parses the last line if it was not terminated, now is the end of the build */
+	void finish (Clock::time_point now = Clock::now ());
+
+	/** between 0 and 1, negative as long as the output contained no progress */
+	double getProgress () const { return progress; }
+	/** in the order the targets were started */
+	std::vector<TargetTime> getTargetTimes () const;
+
+private:
+	struct Target
+	{
+		std::string name;
+		Clock::time_point firstOutput;
+		/** the line following the last output line of the target */
+		Clock::time_point end;
+	};
+
+	void parseLine (const std::string& line, Clock::time_point now);
+	void onTargetOutput (std::string&& name, Clock::time_point now);
+	void endOpenTargets (Clock::time_point now);
+
+	std::string partialLine;
+	double progress {-1.};
+	std::vector<Target> targets;
+	/** indices of the targets whose last output line was the last line so far */
+	std::vector<size_t> openTargets;
+};
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
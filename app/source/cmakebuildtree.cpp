@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "cmakebuildtree.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+/** cmake writes forward slashes to the cache */
+std::string normalizePath (std::string path)
+{
+	std::replace (path.begin (), path.end (), '\\', '/');
+	while (path.size () > 1 && path.back () == '/')
+		path.pop_back ();
+	return path;
+}
+
+//------------------------------------------------------------------------
+std::string getEnvironmentVariable (const char* name)
+{
+	if (auto value = std::getenv (name))
+		return value;
+	return {};
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+VSTGUI::Optional<CMakeBuildTree> loadCMakeBuildTree (const std::string& buildDir)
+{
+	std::ifstream stream (buildDir + "/CMakeCache.txt", std::ios::in | std::ios::binary);
+	if (!stream.is_open ())
+		return {};
+
+	CMakeBuildTree tree;
+	bool hasGenerator = false;
+	std::string line;
+	while (std::getline (stream, line))
+	{
+		if (!line.empty () && line.back () == '\r')
+			line.pop_back ();
+		if (line.empty () || line[0] == '#' || line.compare (0, 2, "//") == 0)
+			continue;
+		// KEY:TYPE=VALUE
+		auto typePos = line.find (':');
+		auto valuePos = line.find ('=');
+		if (typePos == std::string::npos || valuePos == std::string::npos || valuePos < typePos)
+			continue;
+		auto key = line.substr (0, typePos);
+		auto value = line.substr (valuePos + 1);
+		if (key == "CMAKE_HOME_DIRECTORY")
+			tree.sourceDir = std::move (value);
+		else if (key == "CMAKE_GENERATOR")
+		{
+			tree.generator = std::move (value);
+			hasGenerator = true;
+		}
+		else if (key == "CMAKE_GENERATOR_PLATFORM")
+			tree.platform = std::move (value);
+		else if (key == "CMAKE_GENERATOR_TOOLSET")
+			tree.toolset = std::move (value);
+		else if (key == "CMAKE_TOOLCHAIN_FILE")
+			tree.toolchainFile = std::move (value);
+	}
+	// cmake could not even select a generator for this folder
+	if (!hasGenerator)
+		return {};
+	return {std::move (tree)};
+}
+
+//------------------------------------------------------------------------
+bool canReuseCMakeBuildTree (const std::string& buildDir, const std::string& sourceDir,
+                             const std::string& generator, const std::string& platform)
+{
+	auto tree = loadCMakeBuildTree (buildDir);
+	if (!tree)
+		return false;
+	auto toolset = getEnvironmentVariable ("CMAKE_GENERATOR_TOOLSET");
+	auto toolchainFile = getEnvironmentVariable ("CMAKE_TOOLCHAIN_FILE");
+	return tree->generator == generator && tree->platform == platform &&
+	       tree->toolset == toolset &&
+	       normalizePath (tree->toolchainFile) == normalizePath (toolchainFile) &&
+	       normalizePath (tree->sourceDir) == normalizePath (sourceDir);
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
@@ -0,0 +1,41 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "vstgui/lib/optional.h"
+#include <string>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** The entries of the CMakeCache.txt of a build folder which cannot be changed by configuring the
+ *	folder again */
+struct CMakeBuildTree
+{
+	std::string sourceDir;
+	std::string generator;
+	std::string platform;
+	std::string toolset;
+	std::string toolchainFile;
+};
+
+//------------------------------------------------------------------------
+VSTGUI::Optional<CMakeBuildTree> loadCMakeBuildTree (const std::string& buildDir);
+
+//------------------------------------------------------------------------
+/** an existing build folder keeps its cache and objects if it was configured for the same source
+ *  folder with the same generator and platform. Otherwise cmake refuses to configure it and it has
+ *  to be deleted. The generated projects are configured without a toolset and a toolchain file,
+ *  so cmake takes them from the environment, and a folder configured with other ones uses a
+ *  different compiler and is not reused either. */
+bool canReuseCMakeBuildTree (const std::string& buildDir, const std::string& sourceDir,
+                             const std::string& generator, const std::string& platform);
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
@@ -2,7 +2,16 @@
 // Flags       : clang-format SMTGSequencer
 
 #include "cmakecapabilities.h"
+#include "filesystem.h"
 #include "include/rapidjson/document.h"
+#include "include/rapidjson/reader.h"
+#include "include/rapidjson/stringbuffer.h"
+#include "include/rapidjson/writer.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
 
 //------------------------------------------------------------------------
 namespace Steinberg {
@@ -10,79 +19,449 @@ namespace Vst {
 namespace ProjectCreator {
 
 //------------------------------------------------------------------------
-auto parseCMakeCapabilities (const std::string& capabilitesJSON)
-    -> VSTGUI::Optional<CMakeCapabilites>
-{
-	using namespace rapidjson;
+namespace {
 
-	CMakeCapabilites cap;
+//------------------------------------------------------------------------
+/** builds the CMakeCapabilites while the JSON is read.
+ *
+ *	The strings of the insitu parsed JSON are referenced until a generator object is complete,
+ *	only the final names are copied.
+ */
+struct CapabilitiesHandler
+: rapidjson::BaseReaderHandler<rapidjson::UTF8<>, CapabilitiesHandler>
+{
+	enum class Scope
+	{
+		None,
+		Root,
+		Version,
+		Generators,
+		Generator,
+		SupportedPlatforms,
+		ExtraGenerators,
+		Done,
+	};
 
-	try
+	struct StringRef
 	{
-		Document doc;
-		doc.Parse (capabilitesJSON.data (), capabilitesJSON.size ());
-		if (!doc.IsObject ())
-			return {};
+		const char* str {nullptr};
+		rapidjson::SizeType length {0};
 
-		if (!doc.HasMember ("version") || !doc.HasMember ("generators"))
-			return {};
+		bool operator== (const char* s) const
+		{
+			return length == std::strlen (s) && std::strncmp (str, s, length) == 0;
+		}
+	};
 
-		auto& generators = doc["generators"];
-		auto& version = doc["version"];
-		if (!version.HasMember ("major") || !version.HasMember ("minor") ||
-		    !version.HasMember ("patch") || !generators.IsArray ())
-			return {};
+	CapabilitiesHandler (CMakeCapabilites& cap) : cap (cap)
+	{
+		platforms.reserve (8);
+		extraGenerators.reserve (8);
+	}
 
-		cap.versionMajor = version["major"].GetInt ();
-		cap.versionMinor = version["minor"].GetInt ();
-		cap.versionPatch = version["patch"].GetInt ();
+	bool isComplete () const
+	{
+		return scope == Scope::Done && hasGenerators && hasVersion && versionParts == 0x7;
+	}
 
-		for (const auto& gen : generators.GetArray ())
+	bool StartObject ()
+	{
+		if (skipDepth > 0)
 		{
-			if (!gen.HasMember ("name"))
-				return {};
+			++skipDepth;
+			return true;
+		}
+		switch (scope)
+		{
+			case Scope::None: scope = Scope::Root; return true;
+			case Scope::Root:
+			{
+				if (key == "version")
+				{
+					hasVersion = true;
+					scope = Scope::Version;
+					return true;
+				}
+				if (key == "generators")
+					return false;
+				break;
+			}
+			case Scope::Generators:
+			{
+				generatorName = {};
+				platformSupport = false;
+				platforms.clear ();
+				extraGenerators.clear ();
+				scope = Scope::Generator;
+				return true;
+			}
+			case Scope::SupportedPlatforms: return false;
+			default: break;
+		}
+		return skip ();
+	}
 
-			GeneratorCapabilites genCap;
-			genCap.name = std::string (gen["name"].GetString ());
+	bool EndObject (rapidjson::SizeType)
+	{
+		if (skipDepth > 0)
+		{
+			--skipDepth;
+			return true;
+		}
+		switch (scope)
+		{
+			case Scope::Root: scope = Scope::Done; return true;
+			case Scope::Version: scope = Scope::Root; return true;
+			case Scope::Generator: scope = Scope::Generators; return addGenerator ();
+			default: return false;
+		}
+	}
 
-			if (gen.HasMember ("platformSupport") && gen["platformSupport"].GetBool ())
+	bool StartArray ()
+	{
+		if (skipDepth > 0)
+		{
+			++skipDepth;
+			return true;
+		}
+		switch (scope)
+		{
+			case Scope::Root:
 			{
-				if (gen.HasMember ("supportedPlatforms"))
+				if (key == "generators")
 				{
-					for (auto& platform : gen["supportedPlatforms"].GetArray ())
-					{
-						genCap.platforms.emplace_back (std::string (platform.GetString ()));
-					}
+					hasGenerators = true;
+					scope = Scope::Generators;
+					return true;
 				}
+				if (key == "version")
+					return false;
+				break;
 			}
-
-			cap.generators.emplace_back (genCap);
-			if (gen.HasMember ("extraGenerators"))
+			case Scope::Generator:
 			{
-				for (auto& extraGen : gen["extraGenerators"].GetArray ())
+				if (key == "supportedPlatforms")
 				{
-					if (!extraGen.IsString ())
-						continue;
-					GeneratorCapabilites extraGenCap;
-					extraGenCap.name =
-					    std::string (extraGen.GetString ()) + " - " + std::string (genCap.name);
-					cap.generators.emplace_back (extraGenCap);
+					scope = Scope::SupportedPlatforms;
+					return true;
 				}
+				if (key == "extraGenerators")
+				{
+					scope = Scope::ExtraGenerators;
+					return true;
+				}
+				break;
 			}
+			case Scope::None:
+			case Scope::Generators:
+			case Scope::SupportedPlatforms: return false;
+			default: break;
 		}
-		std::sort (cap.generators.begin (), cap.generators.end (),
-		           [] (const auto& lhs, const auto& rhs) {
-			           return lhs.name.getString () > rhs.name.getString ();
-		           });
+		return skip ();
 	}
-	catch (...)
+
+	bool EndArray (rapidjson::SizeType)
 	{
-		return {};
+		if (skipDepth > 0)
+		{
+			--skipDepth;
+			return true;
+		}
+		switch (scope)
+		{
+			case Scope::Generators: scope = Scope::Root; return true;
+			case Scope::SupportedPlatforms:
+			case Scope::ExtraGenerators: scope = Scope::Generator; return true;
+			default: return false;
+		}
+	}
+
+	bool Key (const char* str, rapidjson::SizeType length, bool)
+	{
+		if (skipDepth == 0)
+			key = {str, length};
+		return true;
+	}
+
+	bool String (const char* str, rapidjson::SizeType length, bool)
+	{
+		if (skipDepth > 0)
+			return true;
+		switch (scope)
+		{
+			case Scope::Generator:
+			{
+				if (key == "name")
+					generatorName = {str, length};
+				return true;
+			}
+			case Scope::SupportedPlatforms: platforms.push_back ({str, length}); return true;
+			case Scope::ExtraGenerators: extraGenerators.push_back ({str, length}); return true;
+			default: return isScalarAllowed ();
+		}
+	}
+
+	bool Bool (bool b)
+	{
+		if (skipDepth == 0 && scope == Scope::Generator && key == "platformSupport")
+			platformSupport = b;
+		return skipDepth > 0 || isScalarAllowed ();
+	}
+
+	bool Int (int i)
+	{
+		if (skipDepth == 0 && scope == Scope::Version)
+		{
+			if (key == "major")
+				return setVersion (cap.versionMajor, 0, i);
+			if (key == "minor")
+				return setVersion (cap.versionMinor, 1, i);
+			if (key == "patch")
+				return setVersion (cap.versionPatch, 2, i);
+		}
+		return skipDepth > 0 || isScalarAllowed ();
+	}
+
+	bool Uint (unsigned i)
+	{
+		if (i > static_cast<unsigned> (std::numeric_limits<int>::max ()))
+			return Default ();
+		return Int (static_cast<int> (i));
+	}
+
+	bool Default () { return skipDepth > 0 || isScalarAllowed (); }
+
+private:
+	bool skip ()
+	{
+		skipDepth = 1;
+		return true;
+	}
+
+	/** scalars are ignored, except where the original format requires something else */
+	bool isScalarAllowed () const
+	{
+		switch (scope)
+		{
+			case Scope::Root:
+				// version must be an object and generators an array
+				return !(key == "version" || key == "generators");
+			case Scope::Version:
+				return !(key == "major" || key == "minor" || key == "patch");
+			case Scope::Generator:
+			case Scope::ExtraGenerators: return true;
+			default: return false;
+		}
+	}
+
+	bool setVersion (int32_t& part, uint32_t index, int value)
+	{
+		part = value;
+		versionParts |= 1 << index;
+		return true;
 	}
 
+	bool addGenerator ()
+	{
+		if (!generatorName.str)
+			return false;
+
+		GeneratorCapabilites genCap;
+		genCap.name = std::string (generatorName.str, generatorName.length);
+		if (platformSupport)
+		{
+			genCap.platforms.reserve (platforms.size ());
+			for (const auto& platform : platforms)
+				genCap.platforms.emplace_back (std::string (platform.str, platform.length));
+		}
+		cap.generators.emplace_back (std::move (genCap));
+		for (const auto& extraGen : extraGenerators)
+		{
+			GeneratorCapabilites extraGenCap;
+			std::string name (extraGen.str, extraGen.length);
+			name += " - ";
+			name.append (generatorName.str, generatorName.length);
+			extraGenCap.name = std::move (name);
+			cap.generators.emplace_back (std::move (extraGenCap));
+		}
+		return true;
+	}
+
+	CMakeCapabilites& cap;
+	Scope scope {Scope::None};
+	uint32_t skipDepth {0};
+	StringRef key;
+
+	bool hasVersion {false};
+	bool hasGenerators {false};
+	uint32_t versionParts {0};
+
+	StringRef generatorName;
+	bool platformSupport {false};
+	std::vector<StringRef> platforms;
+	std::vector<StringRef> extraGenerators;
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+auto CMakeCapabilitiesParser::finish () -> VSTGUI::Optional<CMakeCapabilites>
+{
+	using namespace rapidjson;
+
+	CMakeCapabilites cap;
+	CapabilitiesHandler handler (cap);
+
+	// the parse stack lives in a buffer on the stack, the pool only allocates for very deep JSON
+	char stackBuffer[1024];
+	MemoryPoolAllocator<> allocator (stackBuffer, sizeof (stackBuffer));
+	GenericReader<UTF8<>, UTF8<>, MemoryPoolAllocator<>> reader (&allocator);
+	InsituStringStream stream (&json[0]);
+	auto result = reader.Parse<kParseInsituFlag> (stream, handler);
+	json.clear ();
+	if (result.IsError () || !handler.isComplete ())
+		return {};
+
+	std::sort (cap.generators.begin (), cap.generators.end (),
+	           [] (const auto& lhs, const auto& rhs) {
+		           return lhs.name.getString () > rhs.name.getString ();
+	           });
+	return {std::move (cap)};
+}
+
+//------------------------------------------------------------------------
+auto parseCMakeCapabilities (const std::string& capabilitesJSON)
+    -> VSTGUI::Optional<CMakeCapabilites>
+{
+	CMakeCapabilitiesParser parser;
+	parser.append (capabilitesJSON.data (), capabilitesJSON.size ());
+	return parser.finish ();
+}
+
+//------------------------------------------------------------------------
+auto loadCMakeCapabilitiesCache (const std::string& cacheFile, const std::string& cmakePath)
+    -> VSTGUI::Optional<CMakeCapabilites>
+{
+	using namespace rapidjson;
+
+	auto identity = getFileIdentity (cmakePath);
+	if (!identity)
+		return {};
+
+	std::ifstream stream (cacheFile, std::ios::in | std::ios::binary);
+	if (!stream.is_open ())
+		return {};
+	std::stringstream content;
+	content << stream.rdbuf ();
+	auto json = content.str ();
+
+	// rapidjson asserts on a wrong type, so every value is checked before it is read and a file
+	// which does not match the format is treated like a missing cache
+	Document doc;
+	doc.Parse (json.data (), json.size ());
+	if (!doc.IsObject () || !doc.HasMember ("cmake") || !doc.HasMember ("version") ||
+	    !doc.HasMember ("generators"))
+		return {};
+
+	const auto& cmake = doc["cmake"];
+	if (!cmake.IsObject () || !cmake.HasMember ("path") || !cmake.HasMember ("size") ||
+	    !cmake.HasMember ("mtime") || !cmake.HasMember ("id") || !cmake["path"].IsString () ||
+	    !cmake["size"].IsInt64 () || !cmake["mtime"].IsInt64 () || !cmake["id"].IsUint64 ())
+		return {};
+	FileIdentity cachedIdentity;
+	cachedIdentity.size = cmake["size"].GetInt64 ();
+	cachedIdentity.modificationTime = cmake["mtime"].GetInt64 ();
+	cachedIdentity.fileID = cmake["id"].GetUint64 ();
+	if (cmakePath != cmake["path"].GetString () || cachedIdentity != *identity)
+		return {};
+
+	const auto& version = doc["version"];
+	const auto& generators = doc["generators"];
+	if (!version.IsObject () || !version.HasMember ("major") || !version.HasMember ("minor") ||
+	    !version.HasMember ("patch") || !version["major"].IsInt () || !version["minor"].IsInt () ||
+	    !version["patch"].IsInt () || !generators.IsArray ())
+		return {};
+	CMakeCapabilites cap;
+	cap.versionMajor = version["major"].GetInt ();
+	cap.versionMinor = version["minor"].GetInt ();
+	cap.versionPatch = version["patch"].GetInt ();
+
+	for (const auto& gen : generators.GetArray ())
+	{
+		if (!gen.IsObject () || !gen.HasMember ("name") || !gen.HasMember ("platforms") ||
+		    !gen["name"].IsString () || !gen["platforms"].IsArray ())
+			return {};
+		GeneratorCapabilites genCap;
+		genCap.name = std::string (gen["name"].GetString ());
+		for (const auto& platform : gen["platforms"].GetArray ())
+		{
+			if (!platform.IsString ())
+				return {};
+			genCap.platforms.emplace_back (std::string (platform.GetString ()));
+		}
+		cap.generators.emplace_back (std::move (genCap));
+	}
 	return {std::move (cap)};
 }
 
+//------------------------------------------------------------------------
+bool storeCMakeCapabilitiesCache (const std::string& cacheFile, const std::string& cmakePath,
+                                  const CMakeCapabilites& capabilities)
+{
+	using namespace rapidjson;
+
+	auto identity = getFileIdentity (cmakePath);
+	if (!identity)
+		return false;
+
+	StringBuffer buffer;
+	Writer<StringBuffer> writer (buffer);
+	writer.StartObject ();
+	writer.Key ("cmake");
+	writer.StartObject ();
+	writer.Key ("path");
+	writer.String (cmakePath.data (), static_cast<SizeType> (cmakePath.size ()));
+	writer.Key ("size");
+	writer.Int64 (identity->size);
+	writer.Key ("mtime");
+	writer.Int64 (identity->modificationTime);
+	writer.Key ("id");
+	writer.Uint64 (identity->fileID);
+	writer.EndObject ();
+	writer.Key ("version");
+	writer.StartObject ();
+	writer.Key ("major");
+	writer.Int (capabilities.versionMajor);
+	writer.Key ("minor");
+	writer.Int (capabilities.versionMinor);
+	writer.Key ("patch");
+	writer.Int (capabilities.versionPatch);
+	writer.EndObject ();
+	writer.Key ("generators");
+	writer.StartArray ();
+	for (const auto& gen : capabilities.generators)
+	{
+		writer.StartObject ();
+		writer.Key ("name");
+		writer.String (gen.name.data ());
+		writer.Key ("platforms");
+		writer.StartArray ();
+		for (const auto& platform : gen.platforms)
+			writer.String (platform.data ());
+		writer.EndArray ();
+		writer.EndObject ();
+	}
+	writer.EndArray ();
+	writer.EndObject ();
+
+	std::ofstream stream (cacheFile, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!stream.is_open ())
+		return false;
+	stream.write (buffer.GetString (), buffer.GetSize ());
+	return stream.good ();
+}
+
 //------------------------------------------------------------------------
 } // ProjectCreator
 } // Vst
@@ -5,6 +5,7 @@
 
 #include "vstgui/lib/cstring.h"
 #include "vstgui/lib/optional.h"
+#include <string>
 #include <vector>
 
 //------------------------------------------------------------------------
@@ -18,6 +19,11 @@ struct GeneratorCapabilites
 	VSTGUI::UTF8String name;
 
 	std::vector<VSTGUI::UTF8String> platforms;
+
+	bool operator== (const GeneratorCapabilites& o) const
+	{
+		return name == o.name && platforms == o.platforms;
+	}
 };
 
 struct CMakeCapabilites
@@ -27,11 +33,46 @@ struct CMakeCapabilites
 	int32_t versionPatch {0};
 
 	std::vector<GeneratorCapabilites> generators;
+
+	bool operator== (const CMakeCapabilites& o) const
+	{
+		return versionMajor == o.versionMajor && versionMinor == o.versionMinor &&
+		       versionPatch == o.versionPatch && generators == o.generators;
+	}
+	bool operator!= (const CMakeCapabilites& o) const { return !(*this == o); }
+};
+
+//------------------------------------------------------------------------
+/** Parser for the output of "cmake -E capabilities".
+ *
+ *	The output is collected while it arrives and parsed in place with a SAX handler when finish is
+ *	called. The JSON reader can not be suspended in the middle of a value, so parsing starts at
+ *	EOF, but without building a DOM.
+ */
+class CMakeCapabilitiesParser
+{
+public:
+	CMakeCapabilitiesParser () { json.reserve (16 * 1024); }
+
+	void append (const char* data, size_t size) { json.append (data, size); }
+	/** the collected output is consumed */
+	VSTGUI::Optional<CMakeCapabilites> finish ();
+
+private:
+	std::string json;
 };
 
 //------------------------------------------------------------------------
 VSTGUI::Optional<CMakeCapabilites> parseCMakeCapabilities (const std::string& capabilitesJSON);
 
+//------------------------------------------------------------------------
+/** the cache is only valid for the cmake executable with the same path, size, modification time
+ *  and inode */
+VSTGUI::Optional<CMakeCapabilites> loadCMakeCapabilitiesCache (const std::string& cacheFile,
+                                                               const std::string& cmakePath);
+bool storeCMakeCapabilitiesCache (const std::string& cacheFile, const std::string& cmakePath,
+                                  const CMakeCapabilites& capabilities);
+
 //------------------------------------------------------------------------
 } // ProjectCreator
 } // Vst
@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "cmakediscovery.h"
+#include "filesystem.h"
+#include "vstgui/standalone/include/iasync.h"
+#include <algorithm>
+#include <cstdlib>
+#include <future>
+#include <sstream>
+#include <tuple>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+using namespace VSTGUI::Standalone;
+
+//------------------------------------------------------------------------
+namespace {
+
+#if WINDOWS
+constexpr auto PlatformPathDelimiter = '\\';
+constexpr auto EnvPathSeparator = ';';
+constexpr auto CMakeExecutableName = "CMake.exe";
+constexpr auto NinjaExecutableName = "ninja.exe";
+constexpr auto CompilerLauncherNames = {"ccache.exe", "sccache.exe"};
+#else
+constexpr auto PlatformPathDelimiter = '/';
+constexpr auto EnvPathSeparator = ':';
+constexpr auto CMakeExecutableName = "cmake";
+constexpr auto NinjaExecutableName = "ninja";
+constexpr auto CompilerLauncherNames = {"ccache", "sccache"};
+#endif
+
+//------------------------------------------------------------------------
+void addDirectory (std::vector<std::string>& directories, std::string dir)
+{
+	if (dir.empty ())
+		return;
+	if (*dir.rbegin () != PlatformPathDelimiter)
+		dir += PlatformPathDelimiter;
+	if (std::find (directories.begin (), directories.end (), dir) == directories.end ())
+		directories.emplace_back (std::move (dir));
+}
+
+//------------------------------------------------------------------------
+bool hasNinjaGenerator (const CMakeCapabilites& capabilities)
+{
+	return std::any_of (capabilities.generators.begin (), capabilities.generators.end (),
+	                    [] (const auto& gen) { return gen.name.getString () == "Ninja"; });
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+std::shared_ptr<CMakeDiscovery> CMakeDiscovery::create (
+    const std::shared_ptr<ProcessExecutor>& executor)
+{
+	auto discovery = std::make_shared<CMakeDiscovery> ();
+	discovery->executor = executor;
+	return discovery;
+}
+
+//------------------------------------------------------------------------
+void CMakeDiscovery::run (CompletionFunction&& completionFunc)
+{
+	completion = std::move (completionFunc);
+	auto self = shared_from_this ();
+	Async::schedule (Async::backgroundQueue (), [self] () {
+		auto result = scan (getSearchDirectories ());
+		Async::schedule (Async::mainQueue (),
+		                 [self, result] () { self->queryCapabilities (result); });
+	});
+}
+
+//------------------------------------------------------------------------
+auto CMakeDiscovery::getSearchDirectories () -> std::vector<std::string>
+{
+	std::vector<std::string> directories;
+	if (auto envPath = std::getenv ("PATH"))
+	{
+		std::istringstream input;
+		input.str (envPath);
+		std::string el;
+		while (std::getline (input, el, EnvPathSeparator))
+			addDirectory (directories, std::move (el));
+	}
+#if WINDOWS
+	for (auto envName : {"ProgramFiles", "ProgramFiles(x86)", "ProgramW6432"})
+	{
+		if (auto programFiles = std::getenv (envName))
+			addDirectory (directories, std::string (programFiles) + "\\CMake\\bin");
+	}
+#else
+	for (auto dir : {"/usr/local/bin", "/usr/bin", "/opt/homebrew/bin", "/opt/local/bin"})
+		addDirectory (directories, dir);
+#if MAC
+	addDirectory (directories, "/Applications/CMake.app/Contents/bin");
+#else
+	addDirectory (directories, "/snap/bin");
+#endif
+#endif
+	return directories;
+}
+
+//------------------------------------------------------------------------
+auto CMakeDiscovery::scan (const std::vector<std::string>& directories) -> ScanResult
+{
+	struct Probe
+	{
+		bool isCMake {false};
+		bool isNinja {false};
+		VSTGUI::Optional<FileIdentity> identity;
+	};
+
+	// directories on network shares or sleeping disks may block, so all are probed concurrently
+	std::vector<std::future<Probe>> probes;
+	probes.reserve (directories.size ());
+	for (const auto& dir : directories)
+	{
+		probes.emplace_back (std::async (std::launch::async, [dir] () {
+			Probe probe;
+			auto cmakePath = dir + CMakeExecutableName;
+			probe.isCMake = isExecutableFile (cmakePath);
+			if (probe.isCMake)
+				probe.identity = getFileIdentity (cmakePath);
+			probe.isNinja = isExecutableFile (dir + NinjaExecutableName);
+			return probe;
+		}));
+	}
+
+	ScanResult result;
+	std::vector<FileIdentity> identities;
+	for (size_t i = 0; i < probes.size (); ++i)
+	{
+		auto probe = probes[i].get ();
+		if (probe.isNinja)
+			result.ninjaFound = true;
+		if (!probe.isCMake)
+			continue;
+		// the same executable may be found via symlinked directories
+		if (probe.identity)
+		{
+			if (std::find (identities.begin (), identities.end (), *probe.identity) !=
+			    identities.end ())
+				continue;
+			identities.emplace_back (*probe.identity);
+		}
+		result.cmakePaths.emplace_back (directories[i] + CMakeExecutableName);
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+void CMakeDiscovery::queryCapabilities (const ScanResult& scanResult)
+{
+	numPendingQueries = scanResult.cmakePaths.size ();
+	if (numPendingQueries == 0)
+	{
+		onQueryFinished ();
+		return;
+	}
+	auto self = shared_from_this ();
+	for (size_t index = 0; index < scanResult.cmakePaths.size (); ++index)
+	{
+		const auto& path = scanResult.cmakePaths[index];
+		auto parser = std::make_shared<CMakeCapabilitiesParser> ();
+		ProcessExecutor::Job job;
+		job.path = path;
+		job.arguments.add ("-E");
+		job.arguments.add ("capabilities");
+		job.callback = [self, parser, path, index,
+		                ninjaFound = scanResult.ninjaFound] (Process::CallbackParams& p) {
+			parser->append (p.buffer.data (), p.buffer.size ());
+			if (!p.isEOF)
+				return;
+			if (auto capabilities = parser->finish ())
+			{
+				Candidate candidate;
+				candidate.order = index;
+				candidate.installation.path = path;
+				candidate.installation.ninjaAvailable =
+				    ninjaFound && hasNinjaGenerator (*capabilities);
+				candidate.installation.capabilities = std::move (*capabilities);
+				self->candidates.emplace_back (std::move (candidate));
+			}
+			if (--self->numPendingQueries == 0)
+				self->onQueryFinished ();
+		};
+		executor->submit (std::move (job));
+	}
+}
+
+//------------------------------------------------------------------------
+void CMakeDiscovery::onQueryFinished ()
+{
+	std::sort (candidates.begin (), candidates.end (), [] (const auto& lhs, const auto& rhs) {
+		const auto& l = lhs.installation;
+		const auto& r = rhs.installation;
+		return std::make_tuple (!l.ninjaAvailable, -l.capabilities.versionMajor,
+		                        -l.capabilities.versionMinor, -l.capabilities.versionPatch,
+		                        lhs.order) <
+		       std::make_tuple (!r.ninjaAvailable, -r.capabilities.versionMajor,
+		                        -r.capabilities.versionMinor, -r.capabilities.versionPatch,
+		                        rhs.order);
+	});
+	InstallationList installations;
+	installations.reserve (candidates.size ());
+	for (auto& candidate : candidates)
+		installations.emplace_back (std::move (candidate.installation));
+	candidates.clear ();
+
+	auto completionFunc = std::move (completion);
+	if (completionFunc)
+		completionFunc (std::move (installations));
+}
+
+//------------------------------------------------------------------------
+std::string findCompilerLauncher ()
+{
+	for (const auto& dir : CMakeDiscovery::getSearchDirectories ())
+	{
+		for (auto name : CompilerLauncherNames)
+		{
+			auto path = dir + name;
+			if (isExecutableFile (path))
+				return path;
+		}
+	}
+	return {};
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "cmakecapabilities.h"
+#include "processexecutor.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+struct CMakeInstallation
+{
+	std::string path;
+	CMakeCapabilites capabilities;
+	/** the Ninja generator is supported and a ninja executable was found */
+	bool ninjaAvailable {false};
+};
+
+//------------------------------------------------------------------------
+/** Finds all cmake executables in PATH and in well-known install locations.
+ *
+ *	The file system is scanned concurrently on the background queue, then the capabilities of
+ *	all found executables are queried in parallel via the executor. The installations are ranked
+ *	by Ninja availability first, then by version. Executables which are reachable via several
+ *	paths are only reported once.
+ *
+ *	Must be started on the main thread, the completion is called there.
+ */
+class CMakeDiscovery : public std::enable_shared_from_this<CMakeDiscovery>
+{
+public:
+	using InstallationList = std::vector<CMakeInstallation>;
+	/** the best installation is the first one */
+	using CompletionFunction = std::function<void (InstallationList&& installations)>;
+
+	static std::shared_ptr<CMakeDiscovery> create (
+	    const std::shared_ptr<ProcessExecutor>& executor);
+
+	void run (CompletionFunction&& completion);
+
+	/** the directories of PATH first, then the well-known install locations */
+	static std::vector<std::string> getSearchDirectories ();
+
+private:
+	struct ScanResult
+	{
+		std::vector<std::string> cmakePaths;
+		bool ninjaFound {false};
+	};
+	struct Candidate
+	{
+		/** index in the search order, keeps the ranking stable */
+		size_t order {0};
+		CMakeInstallation installation;
+	};
+
+	static ScanResult scan (const std::vector<std::string>& directories);
+
+	void queryCapabilities (const ScanResult& scanResult);
+	void onQueryFinished ();
+
+	std::shared_ptr<ProcessExecutor> executor;
+	CompletionFunction completion;
+	std::vector<Candidate> candidates;
+	size_t numPendingQueries {0};
+};
+
+//------------------------------------------------------------------------
+/** Finds a compiler cache (ccache or sccache) in the same directories as the cmake executables.
+ *
+ *	Blocks while the file system is probed, so it should be called on the background queue.
+ *	Returns an empty string if no compiler cache is installed.
+ */
+std::string findCompilerLauncher ();
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
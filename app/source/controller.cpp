@@ -2,16 +2,21 @@
 // Flags       : clang-format SMTGSequencer
 
 #include "controller.h"
+#include "appcaches.h"
+#include "buildprogress.h"
+#include "cmakebuildtree.h"
+#include "cmakediscovery.h"
 #include "dimmviewcontroller.h"
 #include "linkcontroller.h"
 #include "process.h"
+#include "processpipeline.h"
+#include "projectsettings.h"
 #include "scriptscrollviewcontroller.h"
 #include "version.h"
 
 #include "vstgui/lib/controls/ctextedit.h"
 #include "vstgui/lib/controls/itexteditlistener.h"
 
-#include "vstgui/lib/cdropsource.h"
 #include "vstgui/lib/cfileselector.h"
 #include "vstgui/standalone/include/helpers/preferences.h"
 #include "vstgui/standalone/include/helpers/value.h"
@@ -22,7 +27,10 @@
 
 #include <array>
 #include <cassert>
+#include <chrono>
+#include <cstdio>
 #include <fstream>
+#include <thread>
 
 //------------------------------------------------------------------------
 namespace Steinberg {
@@ -37,12 +45,8 @@ namespace {
 
 #if WINDOWS
 constexpr auto PlatformPathDelimiter = '\\';
-constexpr auto EnvPathSeparator = ';';
-constexpr auto CMakeExecutableName = "CMake.exe";
 #else
 constexpr auto PlatformPathDelimiter = '/';
-constexpr auto EnvPathSeparator = ':';
-constexpr auto CMakeExecutableName = "cmake";
 #endif
 
 //------------------------------------------------------------------------
@@ -74,24 +78,6 @@ void showSimpleAlert (const char* headline, const char* description)
 	IApplication::instance ().showAlertBoxForWindow (config);
 }
 
-//------------------------------------------------------------------------
-size_t makeValidCppName (std::string& str, bool allowColon = false, char replaceChar = '_')
-{
-	size_t replaced = 0;
-	char numericEndVal = allowColon ? 0x3B : 0x3A;
-	std::replace_if (str.begin (), str.end (),
-	                 [&] (auto c) {
-		                 // allowed: 0...9, A...Z and a...z
-		                 auto legal = (c >= 0x30 && c < numericEndVal) || (c >= 0x41 && c < 0x5B) ||
-		                              (c >= 0x61 && c < 0x7B) || c == replaceChar;
-		                 if (!legal)
-			                 replaced++;
-		                 return !legal;
-	                 },
-	                 replaceChar);
-	return replaced;
-}
-
 //------------------------------------------------------------------------
 void makeValidCppValueString (IValue& value, bool allowColon = false)
 {
@@ -136,6 +122,75 @@ UTF8String getModelValueString (VSTGUI::Standalone::UIDesc::ModelBindingCallback
 	return {};
 }
 
+//------------------------------------------------------------------------
+UTF8String getModelListValueString (VSTGUI::Standalone::UIDesc::ModelBindingCallbacksPtr model,
+                                    const UTF8String& key)
+{
+	if (auto value = model->getValue (key))
+		return value->getConverter ().valueAsString (value->getValue ());
+	return {};
+}
+
+//------------------------------------------------------------------------
+/** empty for the default platform of the generator */
+std::string getSelectedCMakePlatform (VSTGUI::Standalone::UIDesc::ModelBindingCallbacksPtr model)
+{
+	auto platform = getModelListValueString (model, valueIdCMakeSupportedPlatforms);
+	if (platform == "Defaults")
+		return {};
+	return platform.getString ();
+}
+
+//------------------------------------------------------------------------
+void appendProcessOutput (ScriptOutput& output, const Process::CallbackParams& p)
+{
+	output.append (p.buffer.data (), p.buffer.size ());
+	output.append (p.errorBuffer.data (), p.errorBuffer.size ());
+}
+
+//------------------------------------------------------------------------
+std::string describeProcessResult (const char* stepName, const Process::CallbackParams& p)
+{
+	const auto& usage = p.resourceUsage;
+	std::array<char, 256> str;
+	auto len = snprintf (str.data (), str.size (),
+	                     "\n[%s] exit code %d, %.2f s (user %.2f s, sys %.2f s, max RSS %.1f MB)\n",
+	                     stepName, p.resultCode, usage.wallTime, usage.userTime, usage.systemTime,
+	                     static_cast<double> (usage.maxResidentSetSize) / (1024. * 1024.));
+	if (len <= 0)
+		return {};
+	return std::string (str.data (), std::min (static_cast<size_t> (len), str.size () - 1));
+}
+
+//------------------------------------------------------------------------
+std::string describeOutputStatistics (const ScriptOutput::Statistics& stats)
+{
+	std::array<char, 256> str;
+	auto len = snprintf (str.data (), str.size (),
+	                     "\n[output] %llu appends, %llu merged, %llu dropped, %llu notifications\n",
+	                     static_cast<unsigned long long> (stats.appends),
+	                     static_cast<unsigned long long> (stats.mergedAppends),
+	                     static_cast<unsigned long long> (stats.droppedNotifications),
+	                     static_cast<unsigned long long> (stats.flushes));
+	if (len <= 0)
+		return {};
+	return std::string (str.data (), std::min (static_cast<size_t> (len), str.size () - 1));
+}
+
+//------------------------------------------------------------------------
+std::string describeTargetTimes (const std::vector<BuildProgressParser::TargetTime>& targets)
+{
+	std::string result;
+	std::array<char, 256> str;
+	for (const auto& target : targets)
+	{
+		snprintf (str.data (), str.size (), "[build] %s ~%.2f s\n", target.name.data (),
+		          target.seconds);
+		result += str.data ();
+	}
+	return result;
+}
+
 //------------------------------------------------------------------------
 class SyncProjectAndClassNameController : public ValueListenerViewController,
                                           public TextEditListenerAdapter,
@@ -214,6 +269,9 @@ void Controller::onSetContentView (IWindow& window, const VSTGUI::SharedPointer<
 //------------------------------------------------------------------------
 Controller::Controller ()
 {
+	processExecutor = ProcessExecutor::create ();
+	scriptOutput = std::make_shared<ScriptOutput> ();
+
 	Preferences prefs;
 	auto vendorPref = prefs.get (valueIdVendorName);
 	auto emailPref = prefs.get (valueIdVendorEMail);
@@ -223,10 +281,6 @@ Controller::Controller ()
 	auto cmakePathPref = prefs.get (valueIdCMakePath);
 	auto pluginPathPref = prefs.get (valueIdPluginPath);
 
-	auto envPaths = getEnvPaths ();
-	if (!cmakePathPref || cmakePathPref->empty ())
-		cmakePathPref = findCMakePath (envPaths);
-
 	model = UIDesc::ModelBindingCallbacks::make ();
 	/* UI only */
 	UTF8String version ("Version ");
@@ -244,8 +298,8 @@ Controller::Controller ()
 		                 v.performEdit (0.);
 	                 }));
 
-	model->addValue (Value::makeStringValue (valueIdScriptOutput, ""),
-	                 UIDesc::ValueCalls::onEndEdit ([this] (IValue& v) { onScriptOutput (); }));
+	// the script output itself is kept in the ScriptOutput buffer
+	model->addValue (Value::makeStringValue (valueIdScriptOutput, ""));
 	model->addValue (Value::make (valueIdScriptRunning),
 	                 UIDesc::ValueCalls::onEndEdit ([this] (IValue& v) {
 		                 onScriptRunning (v.getValue () > 0.5 ? true : false);
@@ -373,6 +427,17 @@ Controller::Controller ()
 	/* cmake version */
 	model->addValue (Value::makeStringValue (valueIdCMakeVersion, "CMake ?.?.?"));
 
+	/* Build the SDK once for all projects, by default OFF */
+	model->addValue (Value::make (valueIdSharedSDKBuild, 0));
+
+	/* Compiler cache, only active if one is installed */
+	model->addValue (Value::make (valueIdUseCompilerCache, 0));
+	model->getValue (valueIdUseCompilerCache)->setActive (false);
+
+	/* Build the project after it was configured, by default OFF */
+	model->addValue (Value::make (valueIdBuildProject, 0));
+	model->addValue (Value::make (valueIdBuildProgress, 0., Value::makePercentConverter ()));
+
 	// HERE add new values when needed (keep the previous order else the uidesc
 	// could not find its values!)
 
@@ -380,7 +445,7 @@ Controller::Controller ()
 	addCreateViewControllerFunc (
 	    "ScriptOutputController",
 	    [this] (const auto& name, auto parent, const auto uiDesc) -> IController* {
-		    return new ScriptScrollViewController (parent, model->getValue (valueIdScriptOutput));
+		    return new ScriptScrollViewController (parent, scriptOutput);
 	    });
 	addCreateViewControllerFunc (
 	    "DimmViewController_CMake",
@@ -475,12 +540,16 @@ void Controller::onScriptRunning (bool state)
 	    valueIdCMakeGenerators,
 	    valueIdCMakeSupportedPlatforms,
 	    valueIdMacOSDeploymentTarget,
+	    valueIdSharedSDKBuild,
+	    valueIdBuildProject,
 	};
 	for (const auto& valueID : valuesToDisable)
 	{
 		if (auto value = model->getValue (valueID))
 			value->setActive (!state);
 	}
+	scriptRunning = state;
+	model->getValue (valueIdUseCompilerCache)->setActive (!state && !compilerLauncher.empty ());
 }
 
 //------------------------------------------------------------------------
@@ -493,13 +562,72 @@ void Controller::onShow (const IWindow& window)
 
 	if (cmakeInstallationVerified)
 		gatherCMakeInformation ();
+	else if (getModelValueString (model, valueIdCMakePath).empty ())
+		discoverCMake ();
+	discoverCompilerLauncher ();
+}
+
+//------------------------------------------------------------------------
+void Controller::discoverCompilerLauncher ()
+{
+	std::weak_ptr<bool> alive = aliveToken;
+	Async::schedule (Async::backgroundQueue (), [this, alive] () {
+		auto path = findCompilerLauncher ();
+		if (path.empty ())
+			return;
+		Async::schedule (Async::mainQueue (), [this, alive, path] () {
+			if (alive.expired ())
+				return;
+			compilerLauncher = path;
+			unixfyPath (compilerLauncher);
+			auto value = model->getValue (valueIdUseCompilerCache);
+			value->setActive (!scriptRunning);
+			Value::performSinglePlainEdit (*value, 1);
+		});
+	});
+}
+
+//------------------------------------------------------------------------
+void Controller::discoverCMake ()
+{
+	auto discovery = CMakeDiscovery::create (processExecutor);
+	std::weak_ptr<bool> alive = aliveToken;
+	discovery->run ([this, alive] (CMakeDiscovery::InstallationList&& installations) {
+		if (alive.expired ())
+			return;
+		// the user may have chosen a cmake executable in the meantime
+		if (installations.empty () || !getModelValueString (model, valueIdCMakePath).empty ())
+			return;
+		auto& best = installations.front ();
+		Value::performStringValueEdit (*model->getValue (valueIdCMakePath), best.path);
+		if (!verifyCMakeInstallation ())
+			return;
+		storeCMakeCapabilitiesInCache (best.path, best.capabilities);
+		applyCMakeCapabilities (std::move (best.capabilities));
+
+		Preferences prefs;
+		if (best.ninjaAvailable && !prefs.get (valueIdCMakeGenerators))
+		{
+			auto generatorsValue = model->getValue (valueIdCMakeGenerators);
+			generatorsValue->performEdit (generatorsValue->getConverter ().stringAsValue ("Ninja"));
+			fillCmakeSupportedPlatforms ("Ninja");
+		}
+
+		auto tabBarValue = model->getValue (valueIdTabBar);
+		if (tabBarValue->getConverter ().normalizedToPlain (tabBarValue->getValue ()) == 0 &&
+		    verifySDKInstallation ())
+			Value::performSinglePlainEdit (*tabBarValue, 1);
+	});
 }
 
 //------------------------------------------------------------------------
 void Controller::onCMakeCapabilityCheckError ()
 {
 	Value::performSinglePlainEdit (*model->getValue (valueIdValidCMakePath), 0);
-	Async::schedule (Async::mainQueue (), [this] () {
+	std::weak_ptr<bool> alive = aliveToken;
+	Async::schedule (Async::mainQueue (), [this, alive] () {
+		if (alive.expired ())
+			return;
 		showSimpleAlert ("Failure",
 		                 "Could not check cmake capabilities. Check your cmake executable path!");
 		Value::performSinglePlainEdit (*model->getValue (valueIdTabBar), 0);
@@ -509,91 +637,114 @@ void Controller::onCMakeCapabilityCheckError ()
 //------------------------------------------------------------------------
 void Controller::gatherCMakeInformation ()
 {
-	auto cmakePathStr = getModelValueString (model, valueIdCMakePath);
-	if (auto process = Process::create (cmakePathStr.getString ()))
+	auto cmakePathStr = getModelValueString (model, valueIdCMakePath).getString ();
+
+	// use the capabilities of the last run of this cmake executable until they are revalidated
+	bool usesCache = false;
+	if (auto capabilities =
+	        loadCMakeCapabilitiesCache (getCMakeCapabilitiesCacheFile (), cmakePathStr))
 	{
-		Process::ArgumentList args;
-		args.add ("-E");
-		args.add ("capabilities");
+		applyCMakeCapabilities (std::move (*capabilities));
+		usesCache = true;
+	}
 
-		auto scriptRunningValue = model->getValue (valueIdScriptRunning);
-		assert (scriptRunningValue);
+	ProcessExecutor::Job job;
+	job.path = cmakePathStr;
+	job.arguments.add ("-E");
+	job.arguments.add ("capabilities");
+
+	auto scriptRunningValue = model->getValue (valueIdScriptRunning);
+	assert (scriptRunningValue);
+	if (!usesCache)
 		Value::performSingleEdit (*scriptRunningValue, 1.);
-		auto outputString = std::make_shared<std::string> ();
-		auto result = process->run (args, [this, scriptRunningValue, outputString,
-		                                   process] (Process::CallbackParams& p) mutable {
-			if (!p.buffer.empty ())
+	auto parser = std::make_shared<CMakeCapabilitiesParser> ();
+	std::weak_ptr<bool> alive = aliveToken;
+	job.callback = [this, alive, scriptRunningValue, parser, usesCache,
+	                cmakePathStr] (Process::CallbackParams& p) {
+		// the executor and this job may outlive the controller
+		if (alive.expired ())
+			return;
+		parser->append (p.buffer.data (), p.buffer.size ());
+		if (p.isEOF)
+		{
+			if (auto capabilities = parser->finish ())
 			{
-				*outputString += std::string (p.buffer.data (), p.buffer.size ());
+				storeCMakeCapabilitiesInCache (cmakePathStr, *capabilities);
+				if (!usesCache || *capabilities != cmakeCapabilities)
+					applyCMakeCapabilities (std::move (*capabilities));
 			}
-			if (p.isEOF)
+			else
 			{
-				if (auto capabilities = parseCMakeCapabilities (*outputString))
-				{
-					cmakeCapabilities = std::move (*capabilities);
-
-					auto cmakeVersionValue = model->getValue (valueIdCMakeVersion);
-					UTF8String str ("CMake ");
-					str += std::to_string (cmakeCapabilities.versionMajor) + "." +
-					       std::to_string (cmakeCapabilities.versionMinor) + "." +
-					       std::to_string (cmakeCapabilities.versionPatch);
-					cmakeVersionValue->beginEdit ();
-					cmakeVersionValue->dynamicCast<IStringValue> ()->setString (
-					    UTF8String (std::move (str)));
-					cmakeVersionValue->endEdit ();
-
-					auto cmakeGeneratorsValue = model->getValue (valueIdCMakeGenerators);
-					assert (cmakeGeneratorsValue);
-					IStringListValue::StringList list;
-					for (auto& item : cmakeCapabilities.generators)
-					{
+				onCMakeCapabilityCheckError ();
+			}
+			if (!usesCache)
+				Value::performSingleEdit (*scriptRunningValue, 0.);
+		}
+	};
+	processExecutor->submit (std::move (job));
+}
+
+//------------------------------------------------------------------------
+void Controller::storeCMakeCapabilitiesInCache (const std::string& cmakePath,
+                                                const CMakeCapabilites& capabilities)
+{
+	auto cacheFile = getCMakeCapabilitiesCacheFile ();
+	if (cacheFile.empty ())
+		return;
+	Async::schedule (Async::backgroundQueue (), [cacheFile, cmakePath, capabilities] () {
+		storeCMakeCapabilitiesCache (cacheFile, cmakePath, capabilities);
+	});
+}
+
+//------------------------------------------------------------------------
+void Controller::applyCMakeCapabilities (CMakeCapabilites&& capabilities)
+{
+	cmakeCapabilities = std::move (capabilities);
+
+	auto cmakeVersionValue = model->getValue (valueIdCMakeVersion);
+	UTF8String str ("CMake ");
+	str += std::to_string (cmakeCapabilities.versionMajor) + "." +
+	       std::to_string (cmakeCapabilities.versionMinor) + "." +
+	       std::to_string (cmakeCapabilities.versionPatch);
+	cmakeVersionValue->beginEdit ();
+	cmakeVersionValue->dynamicCast<IStringValue> ()->setString (UTF8String (std::move (str)));
+	cmakeVersionValue->endEdit ();
+
+	auto cmakeGeneratorsValue = model->getValue (valueIdCMakeGenerators);
+	assert (cmakeGeneratorsValue);
+	IStringListValue::StringList list;
+	for (auto& item : cmakeCapabilities.generators)
+	{
 #if WINDOWS
-						if (item.name.getString ().find ("Win64") == std::string::npos &&
-						    item.name.getString ().find ("ARM") == std::string::npos &&
-						    item.name.getString ().find ("IA64") == std::string::npos)
+		if (item.name.getString ().find ("Win64") == std::string::npos &&
+		    item.name.getString ().find ("ARM") == std::string::npos &&
+		    item.name.getString ().find ("IA64") == std::string::npos)
 #endif // WINDOWS
-							list.emplace_back (item.name);
-					}
-					cmakeGeneratorsValue->dynamicCast<IStringListValue> ()->updateStringList (list);
-
-					Preferences prefs;
-					if (auto generatorPref = prefs.get (valueIdCMakeGenerators))
-					{
-						auto value =
-						    cmakeGeneratorsValue->getConverter ().stringAsValue (*generatorPref);
-						cmakeGeneratorsValue->performEdit (value);
-
-						fillCmakeSupportedPlatforms (generatorPref->getString ());
-
-						if (auto supportedPlatformPref = prefs.get (valueIdCMakeSupportedPlatforms))
-						{
-							if (auto platforms = model->getValue (valueIdCMakeSupportedPlatforms))
-							{
-								auto v = platforms->getConverter ().stringAsValue (
-								    *supportedPlatformPref);
-								platforms->performEdit (v);
-							}
-						}
-					}
-					else
-					{
-						// we should use some defaults here
-					}
-				}
-				else
-				{
-					onCMakeCapabilityCheckError ();
-				}
-				Value::performSingleEdit (*scriptRunningValue, 0.);
-				process.reset ();
-			}
-		});
-		if (!result)
+			list.emplace_back (item.name);
+	}
+	cmakeGeneratorsValue->dynamicCast<IStringListValue> ()->updateStringList (list);
+
+	Preferences prefs;
+	if (auto generatorPref = prefs.get (valueIdCMakeGenerators))
+	{
+		auto value = cmakeGeneratorsValue->getConverter ().stringAsValue (*generatorPref);
+		cmakeGeneratorsValue->performEdit (value);
+
+		fillCmakeSupportedPlatforms (generatorPref->getString ());
+
+		if (auto supportedPlatformPref = prefs.get (valueIdCMakeSupportedPlatforms))
 		{
-			Value::performSingleEdit (*scriptRunningValue, 0.);
-			onCMakeCapabilityCheckError ();
+			if (auto platforms = model->getValue (valueIdCMakeSupportedPlatforms))
+			{
+				auto v = platforms->getConverter ().stringAsValue (*supportedPlatformPref);
+				platforms->performEdit (v);
+			}
 		}
 	}
+	else
+	{
+		// we should use some defaults here
+	}
 }
 
 //------------------------------------------------------------------------
@@ -780,336 +931,324 @@ void Controller::createProject ()
 		return;
 	}
 	auto _sdkPathStr = getModelValueString (model, valueIdVSTSDKPath);
-	auto cmakePathStr = getModelValueString (model, valueIdCMakePath).getString ();
 	auto _pluginOutputPathStr = getModelValueString (model, valueIdPluginPath);
-	auto vendorStr = getModelValueString (model, valueIdVendorName).getString ();
-	auto vendorHomePageStr = getModelValueString (model, valueIdVendorURL).getString ();
-	auto emailStr = getModelValueString (model, valueIdVendorEMail).getString ();
-	auto pluginNameStr = getModelValueString (model, valueIdPluginName).getString ();
-	auto filenamePrefixStr = getModelValueString (model, valueIdPluginFilenamePrefix).getString ();
-	auto pluginBundleIDStr = getModelValueString (model, valueIdPluginBundleID).getString ();
-	auto vendorNamspaceStr = getModelValueString (model, valueIdVendorNamespace).getString ();
-	auto pluginClassNameStr = getModelValueString (model, valueIdPluginClassName).getString ();
-	auto pluginMacOSDeploymentTargetStr =
+
+	ProjectSettings settings;
+	settings.vendorName = getModelValueString (model, valueIdVendorName).getString ();
+	settings.vendorHomepage = getModelValueString (model, valueIdVendorURL).getString ();
+	settings.vendorEMail = getModelValueString (model, valueIdVendorEMail).getString ();
+	settings.vendorNamespace = getModelValueString (model, valueIdVendorNamespace).getString ();
+	settings.pluginName = getModelValueString (model, valueIdPluginName).getString ();
+	settings.filenamePrefix =
+	    getModelValueString (model, valueIdPluginFilenamePrefix).getString ();
+	settings.bundleID = getModelValueString (model, valueIdPluginBundleID).getString ();
+	settings.className = getModelValueString (model, valueIdPluginClassName).getString ();
+	settings.macOSDeploymentTarget =
 	    getModelValueString (model, valueIdMacOSDeploymentTarget).getString ();
 	auto pluginTypeValue = model->getValue (valueIdPluginType);
 	assert (pluginTypeValue);
 	auto pluginTypeIndex = static_cast<size_t> (
 	    pluginTypeValue->getConverter ().normalizedToPlain (pluginTypeValue->getValue ()));
-	auto pluginTypeStr = pluginTypeStrings[pluginTypeIndex];
-
-	auto pluginUseVSTGUI = model->getValue (valueIdUseVSTGUI)->getValue () != 0;
+	settings.pluginCategory = pluginTypeStrings[pluginTypeIndex];
+	settings.useVSTGUI = model->getValue (valueIdUseVSTGUI)->getValue () != 0;
+	if (model->getValue (valueIdSharedSDKBuild)->getValue () != 0)
+		settings.sdkPrebuiltCachePath = getSDKPrebuiltCacheFolder ();
+	if (model->getValue (valueIdUseCompilerCache)->getValue () != 0)
+		settings.compilerLauncher = compilerLauncher;
 
 	if (_sdkPathStr.empty () || !validateVSTSDKPath (_sdkPathStr))
 	{
 		showSimpleAlert ("Cannot create Project", "The VST3 SDK path is not correct.");
 		return;
 	}
-	auto sdkPathStr = _sdkPathStr.getString ();
-	unixfyPath (sdkPathStr);
+	settings.sdkPath = _sdkPathStr.getString ();
+	unixfyPath (settings.sdkPath);
 	if (_pluginOutputPathStr.empty ())
 	{
 		showSimpleAlert ("Cannot create Project", "You need to specify an output directory.");
 		return;
 	}
-	auto pluginOutputPathStr = _pluginOutputPathStr.getString ();
-	unixfyPath (pluginOutputPathStr);
-	if (pluginOutputPathStr.find (sdkPathStr) == 0)
+	settings.outputPath = _pluginOutputPathStr.getString ();
+	unixfyPath (settings.outputPath);
+	if (settings.outputPath.find (settings.sdkPath) == 0)
 	{
 		showSimpleAlert ("Cannot create Project",
 		                 "Your output directory must be outside of the SDK directory.");
 		return;
 	}
-	if (pluginNameStr.empty ())
+	if (settings.pluginName.empty ())
 	{
 		showSimpleAlert ("Cannot create Project", "You need to specify a name for your plug-in.");
 		return;
 	}
-	if (pluginBundleIDStr.empty ())
+	if (settings.bundleID.empty ())
 	{
 		showSimpleAlert ("Cannot create Project",
 		                 "You need to specify a Bundle ID (e.g. com.company.pluginame).");
 		return;
 	}
 
-	if (pluginClassNameStr.empty ())
-	{
-		pluginClassNameStr = pluginNameStr;
-		makeValidCppName (pluginClassNameStr);
-	}
-	auto cmakeProjectName = pluginNameStr;
-	makeValidCppName (cmakeProjectName);
-
-	if (auto scriptPath = IApplication::instance ().getCommonDirectories ().get (
+	if (auto scriptDir = IApplication::instance ().getCommonDirectories ().get (
 	        CommonDirectoryLocation::AppResourcesPath))
 	{
-		*scriptPath += "GenerateVST3Plugin.cmake";
+		auto scriptPath = scriptDir->getString () + "GenerateVST3Plugin.cmake";
+		auto definitions = makeGeneratorDefinitions (settings);
 
+		// the script is only run if the native generator fails
 		Process::ArgumentList args;
-		args.add ("-DSMTG_VST3_SDK_SOURCE_DIR_CLI=\"" + sdkPathStr + "\"");
-		args.add ("-DSMTG_GENERATOR_OUTPUT_DIRECTORY_CLI=\"" + pluginOutputPathStr + "\"");
-		args.add ("-DSMTG_PLUGIN_NAME_CLI=\"" + pluginNameStr + "\"");
-		args.add ("-DSMTG_PLUGIN_CATEGORY_CLI=\"" + pluginTypeStr + "\"");
-		args.add ("-DSMTG_CMAKE_PROJECT_NAME_CLI=\"" + cmakeProjectName + "\"");
-		args.add ("-DSMTG_PLUGIN_BUNDLE_NAME_CLI=\"" + pluginNameStr + "\"");
-		args.add ("-DSMTG_PLUGIN_IDENTIFIER_CLI=\"" + pluginBundleIDStr + "\"");
-		args.add ("-DSMTG_MACOS_DEPLOYMENT_TARGET_CLI=\"" + pluginMacOSDeploymentTargetStr + "\"");
-		args.add ("-DSMTG_VENDOR_NAME_CLI=\"" + vendorStr + "\"");
-		args.add ("-DSMTG_VENDOR_HOMEPAGE_CLI=\"" + vendorHomePageStr + "\"");
-		args.add ("-DSMTG_VENDOR_EMAIL_CLI=\"" + emailStr + "\"");
-		if (!filenamePrefixStr.empty ())
-			args.add ("-DSMTG_PREFIX_FOR_FILENAMES_CLI=\"" + filenamePrefixStr + "\"");
-		if (!vendorNamspaceStr.empty ())
-			args.add ("-DSMTG_VENDOR_NAMESPACE_CLI=\"" + vendorNamspaceStr + "\"");
-		if (!pluginClassNameStr.empty ())
-			args.add ("-DSMTG_PLUGIN_CLASS_NAME_CLI=\"" + pluginClassNameStr + "\"");
-
-		if (pluginUseVSTGUI)
-			args.add ("-DSMTG_ENABLE_VSTGUI_SUPPORT_CLI=ON");
-		else
-			args.add ("-DSMTG_ENABLE_VSTGUI_SUPPORT_CLI=OFF");
-
+		for (const auto& definition : definitions)
+			args.add ("-D" + definition.first + "=" + definition.second);
 		args.add ("-P");
-		args.addPath (scriptPath->getString ());
+		args.addPath (scriptPath);
 
-		if (auto process = Process::create (cmakePathStr))
+		auto scriptRunningValue = model->getValue (valueIdScriptRunning);
+		assert (scriptRunningValue);
+		Value::performSingleEdit (*scriptRunningValue, 1.);
+		scriptOutput->clear ();
+		scriptOutput->resetStatistics ();
+
+		auto projectPath = settings.outputPath + PlatformPathDelimiter + settings.pluginName;
+		auto buildDir = projectPath + PlatformPathDelimiter + "build";
+
+		auto pipeline = ProcessPipeline::create (processExecutor);
+		// an existing build folder is configured again, so its cache and objects are kept. It is
+		// only deleted while the project is generated if cmake could not reuse it.
+		ProcessPipeline::StepIDList makeDirDependencies;
+		if (!canReuseCMakeBuildTree (buildDir, projectPath,
+		                             getModelListValueString (model, valueIdCMakeGenerators),
+		                             getSelectedCMakePlatform (model)))
 		{
-			auto scriptRunningValue = model->getValue (valueIdScriptRunning);
-			assert (scriptRunningValue);
-			Value::performSingleEdit (*scriptRunningValue, 1.);
-			auto scriptOutputValue = model->getValue (valueIdScriptOutput);
-			assert (scriptOutputValue);
-
-			Value::performStringValueEdit (*scriptOutputValue, cmakePathStr.data ());
-			Value::performStringAppendValueEdit (*scriptOutputValue, " " + *scriptPath);
-			for (const auto& arg : args.args)
-			{
-				Value::performStringAppendValueEdit (*scriptOutputValue, " " + arg);
-			}
-
-			auto projectPath = pluginOutputPathStr + PlatformPathDelimiter + pluginNameStr;
-			if (!process->run (args, [this, scriptRunningValue, scriptOutputValue, process,
-			                          projectPath] (Process::CallbackParams& p) mutable {
-				    if (!p.buffer.empty ())
-				    {
-					    Value::performStringAppendValueEdit (
-					        *scriptOutputValue, std::string (p.buffer.data (), p.buffer.size ()));
-				    }
-				    if (p.isEOF)
-				    {
-					    assert (scriptRunningValue);
-					    Value::performSingleEdit (*scriptRunningValue, 0.);
-					    if (p.resultCode == 0)
-						    runProjectCMake (projectPath);
-					    process.reset ();
-				    }
-			    }))
-			{
-				showSimpleAlert ("Could not execute CMake", "Please verify your path to CMake!");
-				assert (scriptRunningValue);
-				Value::performSingleEdit (*scriptRunningValue, 0.);
-			}
+			Process::ArgumentList removeArgs;
+			removeArgs.add ("-E");
+			removeArgs.add ("remove_directory");
+			removeArgs.addPath (buildDir);
+			makeDirDependencies.emplace_back (pipeline->addProcessStep (
+			    "remove build folder",
+			    makeCMakeJob ("remove build folder", std::move (removeArgs))));
 		}
+		else
+			scriptOutput->append ("\nReusing the build folder " + buildDir + "\n");
+		auto generateStep = pipeline->addStep (
+		    "generate",
+		    makeGenerateStepFunction (*pipeline, scriptDir->getString (), std::move (definitions),
+		                              std::move (args)));
+		// the build folder lives inside the project folder, creating it before the project is
+		// generated would make the generator find an already existing project folder
+		makeDirDependencies.emplace_back (generateStep);
+		// the complete output is written to a log file in the new build folder
+		Process::ArgumentList makeDirArgs;
+		makeDirArgs.add ("-E");
+		makeDirArgs.add ("make_directory");
+		makeDirArgs.addPath (buildDir);
+		auto makeDirStep = pipeline->addProcessStep (
+		    "create build folder", makeCMakeJob ("create build folder", std::move (makeDirArgs)),
+		    makeDirDependencies);
+		auto transcriptStep = pipeline->addStep (
+		    "start transcript",
+		    [output = scriptOutput, buildDir] (ProcessPipeline::DoneFunction&& done) {
+			    auto path = buildDir + PlatformPathDelimiter + "project_generator.log";
+			    if (!output->startTranscript (path))
+				    output->append ("\nCould not create " + path + "\n");
+			    done (true);
+		    },
+		    {makeDirStep});
+		auto configureStep =
+		    addConfigureStep (*pipeline, projectPath, buildDir, makeConfigureDefinitions (settings),
+		                      {transcriptStep});
+		// the IDE is opened after a successful build, so it does not build the same tree meanwhile
+		auto openDependency = configureStep;
+		if (model->getValue (valueIdBuildProject)->getValue () != 0)
+			openDependency = addBuildStep (*pipeline, buildDir, {configureStep});
+		addOpenProjectStep (*pipeline, buildDir, {openDependency});
+
+		pipeline->run ([pipeline, generateStep, scriptRunningValue,
+		                output = scriptOutput] (bool success) {
+			Value::performSingleEdit (*scriptRunningValue, 0.);
+			// how many appends were merged into one notification of the output view
+			output->append (describeOutputStatistics (output->getStatistics ()));
+			output->flush ();
+			output->stopTranscript ();
+			if (pipeline->getStepState (generateStep) == ProcessPipeline::StepState::Failed)
+				showSimpleAlert ("Could not create Project",
+				                 "Please verify your path to CMake and check the script output!");
+		});
 	}
 }
 
 //------------------------------------------------------------------------
-void Controller::runProjectCMake (const std::string& path)
+auto Controller::makeCMakeJob (const std::string& stepName, Process::ArgumentList&& args)
+    -> ProcessPipeline::MakeJobFunction
 {
-	auto cmakePathStr = getModelValueString (model, valueIdCMakePath);
-	auto value = model->getValue (valueIdCMakeGenerators);
-	assert (value);
-	if (!value)
-		return;
-	auto generator = value->getConverter ().valueAsString (value->getValue ());
-	if (auto process = Process::create (cmakePathStr.getString ()))
-	{
-		auto scriptRunningValue = model->getValue (valueIdScriptRunning);
-		assert (scriptRunningValue);
-		Value::performSingleEdit (*scriptRunningValue, 1.);
-		auto scriptOutputValue = model->getValue (valueIdScriptOutput);
-
-		auto buildDir = path;
-		buildDir += PlatformPathDelimiter;
-		buildDir += "build";
+	auto cmakePathStr = getModelValueString (model, valueIdCMakePath).getString ();
+	auto output = scriptOutput;
+	return [cmakePathStr, stepName, output, args] () {
+		std::string commandLine = "\n" + cmakePathStr;
+		for (const auto& arg : args.args)
+			commandLine += " " + arg;
+		output->append (commandLine + "\n");
+
+		ProcessExecutor::Job job;
+		job.path = cmakePathStr;
+		job.arguments = args;
+		job.callback = [stepName, output] (Process::CallbackParams& p) {
+			appendProcessOutput (*output, p);
+			if (p.isEOF)
+			{
+				output->append (describeProcessResult (stepName.data (), p));
+				output->flush ();
+			}
+		};
+		return job;
+	};
+}
 
-		// first: delete previous build folder
-		Process::ArgumentList prepareArgs;
-		prepareArgs.add ("-E");
-		prepareArgs.add ("remove_directory");
-		prepareArgs.addPath (buildDir);
-		process->run (prepareArgs,
-		              [process] (Process::CallbackParams& p) mutable { process.reset (); });
+//------------------------------------------------------------------------
+auto Controller::makeGenerateStepFunction (const ProcessPipeline& pipeline,
+                                           const std::string& scriptDir,
+                                           GeneratorDefinitions&& definitions,
+                                           Process::ArgumentList&& fallbackArgs)
+    -> ProcessPipeline::StepFunction
+{
+	auto fallback =
+	    pipeline.makeProcessStepFunction (makeCMakeJob ("generate", std::move (fallbackArgs)));
+	auto output = scriptOutput;
+	GeneratorOptions options;
+	options.cacheFile = getTemplateCacheFile ();
+	// regenerating a project only touches the files which changed
+	options.incremental = true;
+	return [scriptDir, definitions, fallback, output,
+	        options] (ProcessPipeline::DoneFunction&& done) {
+		output->append ("\nGenerating the project\n");
+		Async::schedule (Async::backgroundQueue (), [=] () {
+			auto startTime = std::chrono::steady_clock::now ();
+			std::string log;
+			auto variables = makeTemplateVariables (definitions, scriptDir);
+			auto success = generateProject (variables, options, log);
+			auto duration = std::chrono::duration<double> (std::chrono::steady_clock::now () -
+			                                               startTime);
+			Async::schedule (Async::mainQueue (), [=] () {
+				output->append (log);
+				auto doneFunc = done;
+				if (success)
+				{
+					std::array<char, 64> str;
+					snprintf (str.data (), str.size (), "\n[generate] %.3f s\n", duration.count ());
+					output->append (str.data ());
+					output->flush ();
+					doneFunc (true);
+					return;
+				}
+				output->append ("\nFalling back to GenerateVST3Plugin.cmake\n");
+				fallback (std::move (doneFunc));
+			});
+		});
+	};
+}
 
-		// now build the cmake command
-		Process::ArgumentList args;
+//------------------------------------------------------------------------
+auto Controller::addConfigureStep (ProcessPipeline& pipeline, const std::string& path,
+                                   const std::string& buildDir,
+                                   const GeneratorDefinitions& definitions,
+                                   const ProcessPipeline::StepIDList& dependencies)
+    -> ProcessPipeline::StepID
+{
+	assert (model->getValue (valueIdCMakeGenerators));
+	auto generator = getModelListValueString (model, valueIdCMakeGenerators);
 
-		// Generator Name
-		args.add ("-G");
-		args.addPath (generator.getString ());
+	Process::ArgumentList args;
 
-		// Platform Name
-		if (auto platforms = model->getValue (valueIdCMakeSupportedPlatforms))
-		{
-			auto platform = platforms->getConverter ().valueAsString (platforms->getValue ());
-			if (!platform.empty () && platform != "Defaults")
-				args.add ("-A " + platform.getString ());
-		}
+	// Generator Name
+	args.add ("-G");
+	args.addPath (generator.getString ());
 
-		// Path to Source
-		args.add ("-S");
-		args.addPath (path);
+	// Platform Name
+	auto platform = getSelectedCMakePlatform (model);
+	if (!platform.empty ())
+	{
+		args.add ("-A");
+		args.add (platform);
+	}
 
-		// Path to Build
-		args.add ("-B");
-		args.addPath (buildDir);
+	// Path to Source
+	args.add ("-S");
+	args.addPath (path);
 
-		if (auto pluginUseVSTGUI = model->getValue (valueIdUseVSTGUI)->getValue () != 0)
-			args.add ("-DSMTG_ENABLE_VSTGUI_SUPPORT=ON");
-		else
-			args.add ("-DSMTG_ENABLE_VSTGUI_SUPPORT=OFF");
+	// Path to Build
+	args.add ("-B");
+	args.addPath (buildDir);
 
-		Value::performStringAppendValueEdit (*scriptOutputValue, "\n" + cmakePathStr + " ");
-		for (const auto& a : args.args)
-			Value::performStringAppendValueEdit (*scriptOutputValue, UTF8String (a) + " ");
-		Value::performStringAppendValueEdit (*scriptOutputValue, "\n");
+	for (const auto& definition : definitions)
+		args.addDefinition (definition.first, definition.second);
 
-		bool result = false;
-		if ((process = Process::create (cmakePathStr.getString ())))
-		{
-			result = process->run (args, [this, scriptRunningValue, scriptOutputValue, buildDir,
-			                              process] (Process::CallbackParams& p) mutable {
-				if (!p.buffer.empty ())
-				{
-					Value::performStringAppendValueEdit (
-					    *scriptOutputValue, std::string (p.buffer.data (), p.buffer.size ()));
-				}
-				if (p.isEOF)
-				{
-					assert (scriptRunningValue);
-					Value::performSingleEdit (*scriptRunningValue, 0.);
-					if (p.resultCode == 0)
-						openCMakeGeneratedProject (buildDir);
-					process.reset ();
-				}
-			});
-		}
-		if (!result)
-		{
-			// TODO: Show error
-			Value::performSingleEdit (*scriptRunningValue, 0.);
-		}
-	}
+	return pipeline.addProcessStep ("configure", makeCMakeJob ("configure", std::move (args)),
+	                                dependencies);
 }
 
 //------------------------------------------------------------------------
-void Controller::openCMakeGeneratedProject (const std::string& path)
+auto Controller::addBuildStep (ProcessPipeline& pipeline, const std::string& buildDir,
+                               const ProcessPipeline::StepIDList& dependencies)
+    -> ProcessPipeline::StepID
 {
-	auto cmakePathStr = getModelValueString (model, valueIdCMakePath);
-	if (auto process = Process::create (cmakePathStr.getString ()))
-	{
-		auto scriptOutputValue = model->getValue (valueIdScriptOutput);
-		Process::ArgumentList args;
-		args.add ("--open");
-		args.addPath (path);
-		auto result =
-		    process->run (args, [scriptOutputValue, process] (Process::CallbackParams& p) mutable {
-			    if (!p.buffer.empty ())
-			    {
-				    Value::performStringAppendValueEdit (
-				        *scriptOutputValue, std::string (p.buffer.data (), p.buffer.size ()));
-			    }
+	Process::ArgumentList args;
+	args.add ("--build");
+	args.addPath (buildDir);
+	args.add ("--parallel");
+	args.add (std::to_string (std::max (std::thread::hardware_concurrency (), 1u)));
+
+	auto makeJob = makeCMakeJob ("build", std::move (args));
+	auto progressValue = model->getValue (valueIdBuildProgress);
+	assert (progressValue);
+	auto output = scriptOutput;
+	return pipeline.addProcessStep (
+	    "build",
+	    [makeJob, progressValue, output] () {
+		    Value::performSingleEdit (*progressValue, 0.);
+		    auto parser = std::make_shared<BuildProgressParser> ();
+		    auto job = makeJob ();
+		    auto callback = std::move (job.callback);
+		    job.callback = [parser, progressValue, output,
+		                    callback] (Process::CallbackParams& p) {
+			    parser->append (p.buffer.data (), p.buffer.size ());
+			    if (p.isEOF)
+				    parser->finish ();
+			    auto progress = parser->getProgress ();
+			    if (p.isEOF && p.resultCode == 0)
+				    progress = 1.;
+			    if (progress >= 0.)
+				    Value::performSingleEdit (*progressValue, progress);
+			    callback (p);
 			    if (p.isEOF)
 			    {
-				    process.reset ();
+				    // the total time is part of the process result
+				    output->append (describeTargetTimes (parser->getTargetTimes ()));
+				    output->flush ();
 			    }
-		    });
-		if (!result)
-		{
-			// TODO: Show error
-		}
-	}
+		    };
+		    return job;
+	    },
+	    dependencies);
 }
 
 //------------------------------------------------------------------------
-void Controller::onScriptOutput ()
+auto Controller::addOpenProjectStep (ProcessPipeline& pipeline, const std::string& buildDir,
+                                     const ProcessPipeline::StepIDList& dependencies)
+    -> ProcessPipeline::StepID
 {
+	Process::ArgumentList args;
+	args.add ("--open");
+	args.addPath (buildDir);
+	return pipeline.addProcessStep ("open", makeCMakeJob ("open", std::move (args)), dependencies);
 }
 
 //------------------------------------------------------------------------
 void Controller::copyScriptOutputToClipboard ()
 {
-	if (auto value = model->getValue (valueIdScriptOutput))
-	{
-		if (auto stringValue = value->dynamicCast<IStringValue> ())
-		{
-			if (stringValue->getString ().empty ())
-				return;
-			auto frame = contentView.get ();
-			if (!frame)
-				return;
-			auto data =
-			    CDropSource::create (stringValue->getString ().data (),
-			                         static_cast<uint32_t> (stringValue->getString ().length ()),
-			                         IDataPackage::Type::kText);
-			frame->setClipboard (data);
-		}
-	}
-}
-
-//------------------------------------------------------------------------
-auto Controller::getEnvPaths () -> StringList
-{
-	StringList result;
-	if (auto envPath = std::getenv ("PATH"))
-	{
-		std::istringstream input;
-		input.str (envPath);
-		std::string el;
-		while (std::getline (input, el, EnvPathSeparator))
-		{
-			if (el.empty ())
-				continue;
-			if (*el.rbegin () != PlatformPathDelimiter)
-				el += PlatformPathDelimiter;
-			result.emplace_back (std::move (el));
-		}
-	}
-	return result;
-}
-
-//------------------------------------------------------------------------
-VSTGUI::Optional<UTF8String> Controller::findCMakePath (const StringList& envPaths)
-{
-	if (!envPaths.empty ())
-	{
-		for (auto path : envPaths)
-		{
-			path += CMakeExecutableName;
-			std::ifstream stream (path);
-			if (stream.is_open ())
-			{
-				return {std::move (path)};
-			}
-		}
-	}
-#if !WINDOWS
-	{
-		std::string path = "/usr/local/bin/cmake";
-		std::ifstream stream (path);
-		if (stream.is_open ())
-			return {std::move (path)};
-	}
-#endif
-#if MAC
-	{
-		std::string path = "/Applications/CMake.app/Contents/bin/cmake";
-		std::ifstream stream (path);
-		if (stream.is_open ())
-			return {std::move (path)};
-	}
-#endif
-	return {};
+	if (scriptOutput->getNumBytes () == 0)
+		return;
+	auto frame = contentView.get ();
+	if (!frame)
+		return;
+	frame->setClipboard (scriptOutput->createClipboardData ());
 }
 
 //------------------------------------------------------------------------
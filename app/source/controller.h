@@ -4,6 +4,9 @@
 #pragma once
 
 #include "cmakecapabilities.h"
+#include "processpipeline.h"
+#include "scriptoutput.h"
+#include "templateengine.h"
 #include "vstgui/lib/cfileselector.h"
 #include "vstgui/lib/cframe.h"
 #include "vstgui/standalone/include/helpers/menubuilder.h"
@@ -33,6 +36,10 @@ static constexpr auto valueIdPluginBundleID = "PlugIn Bundle ID";
 static constexpr auto valueIdPluginFilenamePrefix = "PlugIn Filename Prefix";
 static constexpr auto valueIdUseVSTGUI = "Use VSTGUI";
 static constexpr auto valueIdMacOSDeploymentTarget = "macOS Deployment Target";
+static constexpr auto valueIdSharedSDKBuild = "Shared SDK Build";
+static constexpr auto valueIdUseCompilerCache = "Use Compiler Cache";
+static constexpr auto valueIdBuildProject = "Build Project";
+static constexpr auto valueIdBuildProgress = "Build Progress";
 
 static constexpr auto valueIdChooseCMakePath = "Choose CMake Path";
 static constexpr auto valueIdChooseVSTSDKPath = "Choose VST SDK Path";
@@ -63,7 +70,6 @@ public:
 	using IValue = VSTGUI::Standalone::IValue;
 	using CFrame = VSTGUI::CFrame;
 	using UTF8String = VSTGUI::UTF8String;
-	using StringList = std::vector<std::string>;
 
 	Controller ();
 
@@ -89,11 +95,29 @@ private:
 	void showCMakeNotInstalledWarning ();
 	void gatherCMakeInformation ();
 	void onCMakeCapabilityCheckError ();
+	void applyCMakeCapabilities (CMakeCapabilites&& capabilities);
+	void storeCMakeCapabilitiesInCache (const std::string& cmakePath,
+	                                    const CMakeCapabilites& capabilities);
+	void discoverCMake ();
+	void discoverCompilerLauncher ();
 	void fillCmakeSupportedPlatforms (const std::string& currentGenerator);
 
 	void createProject ();
-	void runProjectCMake (const std::string& path);
-	void openCMakeGeneratedProject (const std::string& path);
+	ProcessPipeline::MakeJobFunction makeCMakeJob (const std::string& stepName,
+	                                               Process::ArgumentList&& args);
+	ProcessPipeline::StepFunction makeGenerateStepFunction (const ProcessPipeline& pipeline,
+	                                                        const std::string& scriptDir,
+	                                                        GeneratorDefinitions&& definitions,
+	                                                        Process::ArgumentList&& fallbackArgs);
+	ProcessPipeline::StepID addConfigureStep (ProcessPipeline& pipeline, const std::string& path,
+	                                          const std::string& buildDir,
+	                                          const GeneratorDefinitions& definitions,
+	                                          const ProcessPipeline::StepIDList& dependencies);
+	ProcessPipeline::StepID addBuildStep (ProcessPipeline& pipeline, const std::string& buildDir,
+	                                      const ProcessPipeline::StepIDList& dependencies);
+	ProcessPipeline::StepID addOpenProjectStep (ProcessPipeline& pipeline,
+	                                            const std::string& buildDir,
+	                                            const ProcessPipeline::StepIDList& dependencies);
 
 	template <typename Proc>
 	void runFileSelector (const UTF8String& valueId, VSTGUI::CNewFileSelector::Style style,
@@ -103,17 +127,20 @@ private:
 	bool validateCMakePath (const UTF8String& path);
 	bool validatePluginPath (const UTF8String& path);
 
-	void onScriptOutput ();
 	void onScriptRunning (bool state);
 	void copyScriptOutputToClipboard ();
 
-	StringList getEnvPaths ();
-	VSTGUI::Optional<UTF8String> findCMakePath (const StringList& envPaths);
-
 	VSTGUI::Standalone::UIDesc::ModelBindingCallbacksPtr model;
 	VSTGUI::SharedPointer<CFrame> contentView;
 
 	CMakeCapabilites cmakeCapabilities = {};
+	std::shared_ptr<ProcessExecutor> processExecutor;
+	std::shared_ptr<ScriptOutput> scriptOutput;
+	/** empty if no compiler cache was found */
+	std::string compilerLauncher;
+	bool scriptRunning {false};
+	/** asynchronous completions hold a weak reference and do nothing once it expired */
+	std::shared_ptr<bool> aliveToken {std::make_shared<bool> (true)};
 };
 
 //------------------------------------------------------------------------
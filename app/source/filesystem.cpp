@@ -0,0 +1,566 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "filesystem.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+
+#if WINDOWS
+#include "vstgui/lib/platform/win32/win32support.h"
+#include <Windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if LINUX
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#elif MAC
+#include <copyfile.h>
+#include <sys/clonefile.h>
+#endif
+#endif
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+bool isPathSeparator (char c)
+{
+#if WINDOWS
+	return c == '/' || c == '\\';
+#else
+	return c == '/';
+#endif
+}
+
+//------------------------------------------------------------------------
+FILE* openFile (const std::string& path, bool write)
+{
+#if WINDOWS
+	UTF8StringHelper widePath (path.data ());
+	return _wfopen (widePath.getWideString (), write ? L"wb" : L"rb");
+#else
+	return fopen (path.data (), write ? "wb" : "rb");
+#endif
+}
+
+//------------------------------------------------------------------------
+bool createDirectory (const std::string& path)
+{
+#if WINDOWS
+	UTF8StringHelper widePath (path.data ());
+	if (CreateDirectoryW (widePath.getWideString (), nullptr))
+		return true;
+	if (GetLastError () != ERROR_ALREADY_EXISTS)
+		return false;
+	auto attributes = GetFileAttributesW (widePath.getWideString ());
+	return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+	if (mkdir (path.data (), 0777) == 0)
+		return true;
+	struct stat info;
+	return errno == EEXIST && stat (path.data (), &info) == 0 && S_ISDIR (info.st_mode);
+#endif
+}
+
+//------------------------------------------------------------------------
+bool listFilesRecursive (const std::string& directory, const std::string& prefix,
+                         std::vector<std::string>& relativePaths)
+{
+#if WINDOWS
+	WIN32_FIND_DATAW data;
+	UTF8StringHelper pattern ((directory + "\\*").data ());
+	auto handle = FindFirstFileW (pattern.getWideString (), &data);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+	bool result = true;
+	do
+	{
+		UTF8StringHelper name (data.cFileName);
+		std::string nameStr (name.getUTF8String ());
+		if (nameStr == "." || nameStr == "..")
+			continue;
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+		{
+			// like file(GLOB_RECURSE), links to directories are not followed
+			if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+				continue;
+			result = listFilesRecursive (directory + "\\" + nameStr, prefix + nameStr + "/",
+			                             relativePaths);
+		}
+		else
+			relativePaths.emplace_back (prefix + nameStr);
+	} while (result && FindNextFileW (handle, &data));
+	FindClose (handle);
+	return result;
+#else
+	auto dir = opendir (directory.data ());
+	if (!dir)
+		return false;
+	bool result = true;
+	while (auto entry = readdir (dir))
+	{
+		std::string name (entry->d_name);
+		if (name == "." || name == "..")
+			continue;
+		auto path = directory + "/" + name;
+		struct stat info;
+		// like file(GLOB_RECURSE), links to directories are not followed
+		if (lstat (path.data (), &info) != 0)
+			continue;
+		auto isLink = S_ISLNK (info.st_mode);
+		if (isLink && stat (path.data (), &info) != 0)
+			continue;
+		if (!S_ISDIR (info.st_mode))
+			relativePaths.emplace_back (prefix + name);
+		else if (!isLink && !listFilesRecursive (path, prefix + name + "/", relativePaths))
+		{
+			result = false;
+			break;
+		}
+	}
+	closedir (dir);
+	return result;
+#endif
+}
+
+#if !WINDOWS
+//------------------------------------------------------------------------
+bool writeAll (int fd, const char* data, size_t size)
+{
+	while (size > 0)
+	{
+		auto written = write (fd, data, size);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		data += written;
+		size -= static_cast<size_t> (written);
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool copyFileContent (int from, int to, size_t size)
+{
+#if LINUX
+	// a reflink shares the blocks of the source on copy-on-write file systems
+	if (ioctl (to, FICLONE, from) == 0)
+		return true;
+	// copy_file_range copies inside the kernel and may use a server side copy
+	size_t copied = 0;
+	while (copied < size)
+	{
+		auto result = copy_file_range (from, nullptr, to, nullptr, size - copied, 0);
+		if (result <= 0)
+		{
+			if (result < 0 && errno == EINTR)
+				continue;
+			break;
+		}
+		copied += static_cast<size_t> (result);
+	}
+	while (copied < size)
+	{
+		off_t offset = static_cast<off_t> (copied);
+		auto result = sendfile (to, from, &offset, size - copied);
+		if (result <= 0)
+		{
+			if (result < 0 && errno == EINTR)
+				continue;
+			break;
+		}
+		copied += static_cast<size_t> (result);
+	}
+	if (copied == size)
+		return true;
+	if (lseek (from, static_cast<off_t> (copied), SEEK_SET) < 0 ||
+	    lseek (to, static_cast<off_t> (copied), SEEK_SET) < 0)
+		return false;
+#elif MAC
+	if (fcopyfile (from, to, nullptr, COPYFILE_DATA) == 0)
+		return true;
+	if (lseek (from, 0, SEEK_SET) < 0 || lseek (to, 0, SEEK_SET) < 0 || ftruncate (to, 0) != 0)
+		return false;
+#endif
+	char buffer[64 * 1024];
+	while (true)
+	{
+		auto numRead = read (from, buffer, sizeof (buffer));
+		if (numRead < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		if (numRead == 0)
+			return true;
+		if (!writeAll (to, buffer, static_cast<size_t> (numRead)))
+			return false;
+	}
+}
+#endif
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+Optional<FileIdentity> getFileIdentity (const std::string& path)
+{
+	FileIdentity identity;
+#if WINDOWS
+	UTF8StringHelper widePath (path.data ());
+	auto handle = CreateFileW (widePath.getWideString (), 0,
+	                           FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+	                           OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+		return {};
+	BY_HANDLE_FILE_INFORMATION info;
+	auto result = GetFileInformationByHandle (handle, &info);
+	CloseHandle (handle);
+	if (!result)
+		return {};
+	identity.size = (static_cast<int64_t> (info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+	// FILETIME is in 100 nanosecond intervals
+	identity.modificationTime =
+	    ((static_cast<int64_t> (info.ftLastWriteTime.dwHighDateTime) << 32) |
+	     info.ftLastWriteTime.dwLowDateTime) *
+	    100;
+	identity.fileID = (static_cast<uint64_t> (info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+#else
+	struct stat info;
+	if (stat (path.data (), &info) != 0)
+		return {};
+	identity.size = static_cast<int64_t> (info.st_size);
+#if MAC
+	const auto& mtime = info.st_mtimespec;
+#else
+	const auto& mtime = info.st_mtim;
+#endif
+	identity.modificationTime = static_cast<int64_t> (mtime.tv_sec) * 1000000000 + mtime.tv_nsec;
+	identity.fileID = static_cast<uint64_t> (info.st_ino);
+#endif
+	return {std::move (identity)};
+}
+
+//------------------------------------------------------------------------
+bool isExecutableFile (const std::string& path)
+{
+#if WINDOWS
+	UTF8StringHelper widePath (path.data ());
+	auto attributes = GetFileAttributesW (widePath.getWideString ());
+	return attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+#else
+	struct stat info;
+	if (stat (path.data (), &info) != 0 || !S_ISREG (info.st_mode))
+		return false;
+	return access (path.data (), X_OK) == 0;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool createDirectories (const std::string& path)
+{
+	if (path.empty ())
+		return false;
+	for (size_t pos = 1; pos < path.size (); ++pos)
+	{
+		if (!isPathSeparator (path[pos]) || isPathSeparator (path[pos - 1]))
+			continue;
+#if WINDOWS
+		// drive root
+		if (path[pos - 1] == ':')
+			continue;
+#endif
+		if (!createDirectory (path.substr (0, pos)))
+			return false;
+	}
+	if (isPathSeparator (path.back ()))
+		return true;
+	return createDirectory (path);
+}
+
+//------------------------------------------------------------------------
+Optional<std::string> readFile (const std::string& path)
+{
+	auto file = openFile (path, false);
+	if (!file)
+		return {};
+	std::string content;
+	char buffer[16 * 1024];
+	size_t numRead;
+	while ((numRead = fread (buffer, 1, sizeof (buffer), file)) > 0)
+		content.append (buffer, numRead);
+	auto failed = ferror (file) != 0;
+	fclose (file);
+	if (failed)
+		return {};
+	return {std::move (content)};
+}
+
+//------------------------------------------------------------------------
+bool writeFile (const std::string& path, const std::string& content)
+{
+	auto file = openFile (path, true);
+	if (!file)
+		return false;
+	auto result = fwrite (content.data (), 1, content.size (), file) == content.size ();
+	return fclose (file) == 0 && result;
+}
+
+//------------------------------------------------------------------------
+bool writeFile (const std::string& path, const ByteRangeList& ranges)
+{
+#if WINDOWS
+	auto file = openFile (path, true);
+	if (!file)
+		return false;
+	auto result = std::all_of (ranges.begin (), ranges.end (), [&] (const auto& range) {
+		return fwrite (range.data, 1, range.size, file) == range.size;
+	});
+	return fclose (file) == 0 && result;
+#else
+	auto fd = open (path.data (), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0)
+		return false;
+	std::vector<iovec> vectors;
+	vectors.reserve (ranges.size ());
+	for (const auto& range : ranges)
+	{
+		if (range.size > 0)
+			vectors.push_back ({const_cast<char*> (range.data), range.size});
+	}
+	auto result = true;
+	size_t index = 0;
+	while (result && index < vectors.size ())
+	{
+		auto count = static_cast<int> (std::min<size_t> (vectors.size () - index, IOV_MAX));
+		auto written = writev (fd, vectors.data () + index, count);
+		if (written < 0)
+		{
+			result = errno == EINTR;
+			continue;
+		}
+		// continue a partial write behind the last completely written range
+		auto numWritten = static_cast<size_t> (written);
+		while (index < vectors.size () && numWritten >= vectors[index].iov_len)
+			numWritten -= vectors[index++].iov_len;
+		if (numWritten > 0)
+		{
+			vectors[index].iov_base = static_cast<char*> (vectors[index].iov_base) + numWritten;
+			vectors[index].iov_len -= numWritten;
+		}
+	}
+	return close (fd) == 0 && result;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool copyFile (const std::string& from, const std::string& to)
+{
+#if WINDOWS
+	UTF8StringHelper wideFrom (from.data ());
+	UTF8StringHelper wideTo (to.data ());
+	// a new file, so hard links to the old one keep their content
+	DeleteFileW (wideTo.getWideString ());
+	return CopyFileW (wideFrom.getWideString (), wideTo.getWideString (), FALSE) != 0;
+#else
+	// a new file, so hard links to the old one keep their content
+	if (unlink (to.data ()) != 0 && errno != ENOENT)
+		return false;
+#if MAC
+	// a clone shares the blocks of the source on APFS
+	if (clonefile (from.data (), to.data (), 0) == 0)
+		return true;
+#endif
+	auto fromFd = open (from.data (), O_RDONLY);
+	if (fromFd < 0)
+		return false;
+	struct stat fromStat;
+	if (fstat (fromFd, &fromStat) != 0)
+	{
+		close (fromFd);
+		return false;
+	}
+	auto toFd = open (to.data (), O_WRONLY | O_CREAT | O_TRUNC, fromStat.st_mode & 0777);
+	if (toFd < 0)
+	{
+		close (fromFd);
+		return false;
+	}
+	auto result = copyFileContent (fromFd, toFd, static_cast<size_t> (fromStat.st_size));
+	close (fromFd);
+	return close (toFd) == 0 && result;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool linkFile (const std::string& existing, const std::string& newPath)
+{
+#if WINDOWS
+	UTF8StringHelper wideExisting (existing.data ());
+	UTF8StringHelper wideNewPath (newPath.data ());
+	DeleteFileW (wideNewPath.getWideString ());
+	return CreateHardLinkW (wideNewPath.getWideString (), wideExisting.getWideString (),
+	                        nullptr) != 0;
+#else
+	if (unlink (newPath.data ()) != 0 && errno != ENOENT)
+		return false;
+	return link (existing.data (), newPath.data ()) == 0;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool pathExists (const std::string& path)
+{
+#if WINDOWS
+	UTF8StringHelper widePath (path.data ());
+	return GetFileAttributesW (widePath.getWideString ()) != INVALID_FILE_ATTRIBUTES;
+#else
+	struct stat info;
+	return lstat (path.data (), &info) == 0;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool renamePath (const std::string& from, const std::string& to)
+{
+#if WINDOWS
+	UTF8StringHelper wideFrom (from.data ());
+	UTF8StringHelper wideTo (to.data ());
+	return MoveFileExW (wideFrom.getWideString (), wideTo.getWideString (),
+	                    MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	return rename (from.data (), to.data ()) == 0;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool removeFile (const std::string& path)
+{
+#if WINDOWS
+	UTF8StringHelper widePath (path.data ());
+	return DeleteFileW (widePath.getWideString ()) != 0;
+#else
+	return unlink (path.data ()) == 0;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool removeDirectoryRecursive (const std::string& path)
+{
+#if WINDOWS
+	WIN32_FIND_DATAW data;
+	UTF8StringHelper pattern ((path + "\\*").data ());
+	auto handle = FindFirstFileW (pattern.getWideString (), &data);
+	if (handle != INVALID_HANDLE_VALUE)
+	{
+		do
+		{
+			UTF8StringHelper name (data.cFileName);
+			std::string nameStr (name.getUTF8String ());
+			if (nameStr == "." || nameStr == "..")
+				continue;
+			auto entryPath = path + "\\" + nameStr;
+			if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) &&
+			    !(data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+				removeDirectoryRecursive (entryPath);
+			else if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			{
+				UTF8StringHelper wideEntryPath (entryPath.data ());
+				RemoveDirectoryW (wideEntryPath.getWideString ());
+			}
+			else
+				removeFile (entryPath);
+		} while (FindNextFileW (handle, &data));
+		FindClose (handle);
+	}
+	UTF8StringHelper widePath (path.data ());
+	return RemoveDirectoryW (widePath.getWideString ()) != 0;
+#else
+	if (auto dir = opendir (path.data ()))
+	{
+		while (auto entry = readdir (dir))
+		{
+			std::string name (entry->d_name);
+			if (name == "." || name == "..")
+				continue;
+			auto entryPath = path + "/" + name;
+			struct stat info;
+			if (lstat (entryPath.data (), &info) == 0 && S_ISDIR (info.st_mode))
+				removeDirectoryRecursive (entryPath);
+			else
+				unlink (entryPath.data ());
+		}
+		closedir (dir);
+	}
+	return rmdir (path.data ()) == 0;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool syncFileSystem (const std::string& path)
+{
+#if WINDOWS
+	return true;
+#elif LINUX
+	auto fd = open (path.data (), O_RDONLY);
+	if (fd < 0)
+		return false;
+	auto result = syncfs (fd) == 0;
+	close (fd);
+	return result;
+#else
+	sync ();
+	return true;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool syncDirectory (const std::string& path)
+{
+#if WINDOWS
+	return true;
+#else
+	auto fd = open (path.data (), O_RDONLY | O_DIRECTORY);
+	if (fd < 0)
+		return false;
+	auto result = fsync (fd) == 0;
+	close (fd);
+	return result;
+#endif
+}
+
+//------------------------------------------------------------------------
+bool listFilesRecursive (const std::string& directory, std::vector<std::string>& relativePaths)
+{
+	auto dir = directory;
+	while (dir.size () > 1 && isPathSeparator (dir.back ()))
+		dir.pop_back ();
+	relativePaths.clear ();
+	if (!listFilesRecursive (dir, {}, relativePaths))
+		return false;
+	std::sort (relativePaths.begin (), relativePaths.end ());
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
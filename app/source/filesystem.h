@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "vstgui/lib/optional.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** identifies the content of a file without reading it */
+struct FileIdentity
+{
+	int64_t size {0};
+	/** last modification time in nanoseconds */
+	int64_t modificationTime {0};
+	/** inode on POSIX, file index on Windows */
+	uint64_t fileID {0};
+
+	bool operator== (const FileIdentity& o) const
+	{
+		return size == o.size && modificationTime == o.modificationTime && fileID == o.fileID;
+	}
+	bool operator!= (const FileIdentity& o) const { return !(*this == o); }
+};
+
+//------------------------------------------------------------------------
+struct ByteRange
+{
+	const char* data {nullptr};
+	size_t size {0};
+};
+using ByteRangeList = std::vector<ByteRange>;
+
+//------------------------------------------------------------------------
+VSTGUI::Optional<FileIdentity> getFileIdentity (const std::string& path);
+/** a regular file the current user may execute */
+bool isExecutableFile (const std::string& path);
+
+/** creates the directory and all missing parent directories */
+bool createDirectories (const std::string& path);
+VSTGUI::Optional<std::string> readFile (const std::string& path);
+bool writeFile (const std::string& path, const std::string& content);
+/** writes the ranges one after another with a single gather write where available */
+bool writeFile (const std::string& path, const ByteRangeList& ranges);
+/** copies the content and the permissions, using a copy-on-write clone or an in-kernel copy
+ *  where the platform supports it. An existing file is replaced, not overwritten */
+bool copyFile (const std::string& from, const std::string& to);
+/** replaces an existing file at newPath by a hard link to the existing file */
+bool linkFile (const std::string& existing, const std::string& newPath);
+bool pathExists (const std::string& path);
+/** replaces an existing file at to. Renaming a directory fails if to exists */
+bool renamePath (const std::string& from, const std::string& to);
+bool removeFile (const std::string& path);
+/** removes the directory with all its content, links are removed but not followed */
+bool removeDirectoryRecursive (const std::string& path);
+/** writes the cached data of the file system containing path to disk. Linux only flushes this
+ *  file system, other POSIX systems flush all file systems, Windows does nothing */
+bool syncFileSystem (const std::string& path);
+/** makes renames and new entries in the directory durable, does nothing on Windows */
+bool syncDirectory (const std::string& path);
+/** the regular files below the directory, relative to it with '/' as separator and sorted */
+bool listFilesRecursive (const std::string& directory, std::vector<std::string>& relativePaths);
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
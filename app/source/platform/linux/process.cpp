@@ -4,10 +4,20 @@
 #include "../../process.h"
 #include "vstgui/lib/cvstguitimer.h"
 #include "vstgui/lib/platform/linux/x11platform.h"
+#include "vstgui/lib/platform/platform_x11.h"
 #include <algorithm>
 #include <array>
 #include <cassert>
-#include <stdio.h>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
 
 //------------------------------------------------------------------------
 namespace Steinberg {
@@ -15,77 +25,284 @@ namespace Vst {
 
 using namespace VSTGUI;
 
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+double toSeconds (const timeval& tv)
+{
+	return static_cast<double> (tv.tv_sec) + static_cast<double> (tv.tv_usec) / 1000000.;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
 //------------------------------------------------------------------------
 struct Process::Impl
 {
-	FILE* handle = nullptr;
+	struct Stream : X11::IEventHandler
+	{
+		Impl* owner {nullptr};
+		int fd {-1};
+		bool registered {false};
+
+		void onEvent () override { owner->onDataAvailable (); }
+		bool drain (std::vector<char>& buffer);
+		void close ();
+	};
+
+	pid_t pid {-1};
+	Stream output;
+	Stream error;
+	std::chrono::steady_clock::time_point startTime;
 	CallbackFunction callback;
 	SharedPointer<CVSTGUITimer> timer;
+	SharedPointer<X11::IRunLoop> runLoop;
 	std::string appPathUTF8Str;
 
+	Impl ()
+	{
+		output.owner = this;
+		error.owner = this;
+	}
+
 	~Impl () noexcept
 	{
-		if (handle)
-			pclose (handle);
+		stopObserving ();
+		output.close ();
+		error.close ();
+		if (pid != -1)
+		{
+			if (waitpid (pid, nullptr, WNOHANG) == 0)
+			{
+				kill (pid, SIGTERM);
+				waitpid (pid, nullptr, 0);
+			}
+		}
 	}
+
+	bool spawn (const ArgumentList& arguments);
+	bool startObserving ();
+	void stopObserving ();
+	void closeStream (Stream& stream);
+	void onDataAvailable ();
+	void waitForExit (CallbackParams& params);
 };
 
 //------------------------------------------------------------------------
-std::shared_ptr<Process> Process::create (const std::string& path)
+bool Process::Impl::spawn (const ArgumentList& arguments)
 {
-	auto proc = std::make_shared<Process> ();
-	proc->pImpl = std::make_unique<Process::Impl> ();
-	proc->pImpl->appPathUTF8Str = path;
+	// the arguments are passed as they are to the child, there is no shell involved which
+	// would need to parse a command line
+	std::vector<char*> argv;
+	argv.reserve (arguments.args.size () + 2);
+	argv.emplace_back (const_cast<char*> (appPathUTF8Str.data ()));
+	for (const auto& arg : arguments.args)
+		argv.emplace_back (const_cast<char*> (arg.data ()));
+	argv.emplace_back (nullptr);
 
-	return proc;
+	int outputPipe[2];
+	int errorPipe[2];
+	if (pipe2 (outputPipe, O_CLOEXEC) == -1)
+		return false;
+	if (pipe2 (errorPipe, O_CLOEXEC) == -1)
+	{
+		::close (outputPipe[0]);
+		::close (outputPipe[1]);
+		return false;
+	}
+
+	posix_spawn_file_actions_t fileActions;
+	posix_spawn_file_actions_init (&fileActions);
+	posix_spawn_file_actions_adddup2 (&fileActions, outputPipe[1], STDOUT_FILENO);
+	posix_spawn_file_actions_adddup2 (&fileActions, errorPipe[1], STDERR_FILENO);
+
+	startTime = std::chrono::steady_clock::now ();
+	// a name without a slash is searched in PATH, like the shell did before
+	auto result = posix_spawnp (&pid, appPathUTF8Str.data (), &fileActions, nullptr, argv.data (),
+	                            environ);
+	posix_spawn_file_actions_destroy (&fileActions);
+	::close (outputPipe[1]);
+	::close (errorPipe[1]);
+	output.fd = outputPipe[0];
+	error.fd = errorPipe[0];
+	if (result != 0)
+	{
+		pid = -1;
+		output.close ();
+		error.close ();
+		return false;
+	}
+	return true;
 }
 
 //------------------------------------------------------------------------
-bool Process::run (const ArgumentList& arguments, CallbackFunction&& callback)
+bool Process::Impl::startObserving ()
 {
-	pImpl->callback = std::move (callback);
+	// we read until EAGAIN, so the pipes must never block the UI thread
+	for (auto stream : {&output, &error})
+	{
+		auto flags = fcntl (stream->fd, F_GETFL);
+		if (flags == -1 || fcntl (stream->fd, F_SETFL, flags | O_NONBLOCK) == -1)
+			return false;
+	}
 
-	std::string commandLine;
-	auto lastSeparatorPos = pImpl->appPathUTF8Str.find_last_of ('\\');
-	if (lastSeparatorPos != std::string::npos)
+	runLoop = X11::RunLoop::get ();
+	if (runLoop)
 	{
-		commandLine = pImpl->appPathUTF8Str.substr (lastSeparatorPos + 1);
-		commandLine += " ";
+		output.registered = runLoop->registerEventHandler (output.fd, &output);
+		error.registered = runLoop->registerEventHandler (error.fd, &error);
+		if (output.registered && error.registered)
+			return true;
+		stopObserving ();
 	}
 
-	// Construct the command line arguments for popen, e.g. " -E capabilities"
-	std::string appPath (pImpl->appPathUTF8Str.data ());
-	auto it = arguments.args.begin ();
-	if (it != arguments.args.end ())
-		commandLine += " " + *it;
-	while (++it != arguments.args.end ())
-		commandLine += " " + *it;
-
-	// Construct the full command, e.g. "/usr/bin/cmake -E capabilities"
-	const std::string command = appPath + commandLine;
-
-	pImpl->handle = popen (command.data(), "r");
-	pImpl->timer = makeOwned<CVSTGUITimer> ([&, this] (CVSTGUITimer* timer) {
-		Process::CallbackParams params;
-		
-		constexpr size_t kBufferSize = 256;
-		char plainBuffer[kBufferSize] = {0};
-		if (fgets (plainBuffer, sizeof (plainBuffer), pImpl->handle) != NULL)
+	// no run loop available, fall back to polling the pipes
+	timer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { onDataAvailable (); }, 16);
+	return true;
+}
+
+//------------------------------------------------------------------------
+void Process::Impl::stopObserving ()
+{
+	if (runLoop)
+	{
+		for (auto stream : {&output, &error})
 		{
-			// plainBuffer[255] is '\0', hence -1
-			params.buffer.assign (std::begin (plainBuffer), std::end (plainBuffer) - 1);
+			if (stream->registered)
+				runLoop->unregisterEventHandler (stream);
+			stream->registered = false;
 		}
-		else
+		runLoop = nullptr;
+	}
+	if (timer)
+	{
+		timer->stop ();
+		timer = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------
+void Process::Impl::closeStream (Stream& stream)
+{
+	// the other stream may still be open, stop watching this one before closing it
+	if (runLoop && stream.registered)
+		runLoop->unregisterEventHandler (&stream);
+	stream.registered = false;
+	stream.close ();
+}
+
+//------------------------------------------------------------------------
+bool Process::Impl::Stream::drain (std::vector<char>& buffer)
+{
+	if (fd == -1)
+		return true;
+	// read everything the child has written so far in large blocks. Stop after 1 MB to give
+	// the UI a chance to process the data, the rest is delivered with the next event.
+	constexpr size_t kBlockSize = 64 * 1024;
+	constexpr size_t kMaxBytesPerEvent = 1024 * 1024;
+	while (buffer.size () < kMaxBytesPerEvent)
+	{
+		auto offset = buffer.size ();
+		buffer.resize (offset + kBlockSize);
+		auto numRead = read (fd, buffer.data () + offset, kBlockSize);
+		if (numRead > 0)
 		{
-			params.isEOF = true;
-			params.resultCode = 0;
+			buffer.resize (offset + static_cast<size_t> (numRead));
+			continue;
 		}
+		buffer.resize (offset);
+		if (numRead == 0)
+			return true;
+		if (errno == EINTR)
+			continue;
+		// EAGAIN: nothing more to read for now, any other error ends the stream
+		return errno != EAGAIN && errno != EWOULDBLOCK;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------
+void Process::Impl::Stream::close ()
+{
+	if (fd == -1)
+		return;
+	::close (fd);
+	fd = -1;
+}
+
+//------------------------------------------------------------------------
+void Process::Impl::waitForExit (CallbackParams& params)
+{
+	int status = 0;
+	rusage usage {};
+	if (wait4 (pid, &status, 0, &usage) == pid)
+	{
+		if (WIFEXITED (status))
+			params.resultCode = WEXITSTATUS (status);
+		else if (WIFSIGNALED (status))
+			params.resultCode = 128 + WTERMSIG (status);
+		else
+			params.resultCode = -1;
+		params.resourceUsage.userTime = toSeconds (usage.ru_utime);
+		params.resourceUsage.systemTime = toSeconds (usage.ru_stime);
+		// ru_maxrss is in kilobytes on Linux
+		params.resourceUsage.maxResidentSetSize = static_cast<int64_t> (usage.ru_maxrss) * 1024;
+	}
+	else
+	{
+		params.resultCode = -1;
+	}
+	params.resourceUsage.wallTime =
+	    std::chrono::duration<double> (std::chrono::steady_clock::now () - startTime).count ();
+	pid = -1;
+}
+
+//------------------------------------------------------------------------
+void Process::Impl::onDataAvailable ()
+{
+	Process::CallbackParams params;
+	if (output.drain (params.buffer))
+		closeStream (output);
+	if (error.drain (params.errorBuffer))
+		closeStream (error);
+	if (output.fd == -1 && error.fd == -1)
+	{
+		stopObserving ();
+		waitForExit (params);
+		params.isEOF = true;
+	}
+	if (!params.isEOF)
+	{
+		if (!params.buffer.empty () || !params.errorBuffer.empty ())
+			callback (params);
+		return;
+	}
+	// the callback usually releases the last reference to the process on EOF, so it must not
+	// be owned by this object while it runs
+	auto cb = std::move (callback);
+	cb (params);
+}
+
+//------------------------------------------------------------------------
+std::shared_ptr<Process> Process::create (const std::string& path)
+{
+	auto proc = std::make_shared<Process> ();
+	proc->pImpl = std::make_unique<Process::Impl> ();
+	proc->pImpl->appPathUTF8Str = path;
+
+	return proc;
+}
+
+//------------------------------------------------------------------------
+bool Process::run (const ArgumentList& arguments, CallbackFunction&& callback)
+{
+	pImpl->callback = std::move (callback);
 
-		if (params.isEOF)
-			timer->stop ();
-		if (!params.buffer.empty () || params.isEOF)
-			pImpl->callback (params);
-	});
+	if (!pImpl->spawn (arguments))
+		return false;
+	if (!pImpl->startObserving ())
+		return false;
 
 	return true;
 }
@@ -96,7 +313,13 @@ Process::~Process () noexcept = default;
 //------------------------------------------------------------------------
 void Process::ArgumentList::addPath (const std::string& str)
 {
-	args.emplace_back ("\"" + str + "\"");
+	args.emplace_back (str);
+}
+
+//------------------------------------------------------------------------
+void Process::ArgumentList::addDefinition (const std::string& name, const std::string& value)
+{
+	args.emplace_back ("-D" + name + "=" + value);
 }
 
 //------------------------------------------------------------------------
@@ -2,6 +2,7 @@
 
 #import "../../process.h"
 #import <Cocoa/Cocoa.h>
+#import <chrono>
 
 using namespace Steinberg::Vst;
 using namespace VSTGUI;
@@ -10,11 +11,13 @@ using namespace VSTGUI;
 @interface SMTG_ExternalProcess : NSObject
 {
 	Process::CallbackFunction callback;
+	std::chrono::steady_clock::time_point startTime;
 }
 @property (readwrite, retain) NSTask* task;
 
 - (instancetype)initWithTask:(NSTask*)task;
 - (void)setCallback:(Process::CallbackFunction&&)inCallback;
+- (void)launch;
 
 @end
 
@@ -45,6 +48,13 @@ using namespace VSTGUI;
 	callback = std::move (inCallback);
 }
 
+//------------------------------------------------------------------------
+- (void)launch
+{
+	startTime = std::chrono::steady_clock::now ();
+	[self.task launch];
+}
+
 //------------------------------------------------------------------------
 - (void)dealloc
 {
@@ -71,6 +81,8 @@ using namespace VSTGUI;
 		[self.task waitUntilExit];
 		params.resultCode = self.task.terminationStatus;
 		params.isEOF = true;
+		params.resourceUsage.wallTime =
+		    std::chrono::duration<double> (std::chrono::steady_clock::now () - startTime).count ();
 
 		[[NSNotificationCenter defaultCenter] removeObserver:self];
 		self.task = nil;
@@ -136,7 +148,7 @@ bool Process::run (const ArgumentList& arguments, CallbackFunction&& callback)
 #endif
 
 		[pImpl->delegate setCallback:std::move (callback)];
-		[pImpl->delegate.task launch];
+		[pImpl->delegate launch];
 	}
 	@catch (NSException* exception)
 	{
@@ -154,6 +166,12 @@ void Process::ArgumentList::addPath (const std::string& str)
 	args.emplace_back (str);
 }
 
+//------------------------------------------------------------------------
+void Process::ArgumentList::addDefinition (const std::string& name, const std::string& value)
+{
+	args.emplace_back ("-D" + name + "=" + value);
+}
+
 //------------------------------------------------------------------------
 void Process::ArgumentList::add (const std::string& str)
 {
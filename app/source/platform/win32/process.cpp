@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <psapi.h>
 #include <shellapi.h>
 
 //------------------------------------------------------------------------
@@ -16,6 +17,37 @@ namespace Vst {
 
 using namespace VSTGUI;
 
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+double toSeconds (const FILETIME& time)
+{
+	ULARGE_INTEGER value;
+	value.LowPart = time.dwLowDateTime;
+	value.HighPart = time.dwHighDateTime;
+	// FILETIME is in 100 nanosecond units
+	return static_cast<double> (value.QuadPart) / 10000000.;
+}
+
+//------------------------------------------------------------------------
+void getResourceUsage (HANDLE process, Process::ResourceUsage& usage)
+{
+	FILETIME creationTime {}, exitTime {}, kernelTime {}, userTime {};
+	if (GetProcessTimes (process, &creationTime, &exitTime, &kernelTime, &userTime))
+	{
+		usage.wallTime = toSeconds (exitTime) - toSeconds (creationTime);
+		usage.userTime = toSeconds (userTime);
+		usage.systemTime = toSeconds (kernelTime);
+	}
+	PROCESS_MEMORY_COUNTERS counters {};
+	if (GetProcessMemoryInfo (process, &counters, sizeof (counters)))
+		usage.maxResidentSetSize = static_cast<int64_t> (counters.PeakWorkingSetSize);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
 //------------------------------------------------------------------------
 struct Process::Impl
 {
@@ -125,6 +157,7 @@ bool Process::run (const ArgumentList& arguments, CallbackFunction&& callback)
 			GetExitCodeProcess (pImpl->procInfo.hProcess, &exitCode);
 			params.isEOF = true;
 			params.resultCode = exitCode;
+			getResourceUsage (pImpl->procInfo.hProcess, params.resourceUsage);
 		}
 		if (params.isEOF)
 			timer->stop ();
@@ -144,6 +177,12 @@ void Process::ArgumentList::addPath (const std::string& str)
 	args.emplace_back ("\"" + str + "\"");
 }
 
+//------------------------------------------------------------------------
+void Process::ArgumentList::addDefinition (const std::string& name, const std::string& value)
+{
+	args.emplace_back ("\"-D" + name + "=" + value + "\"");
+}
+
 //------------------------------------------------------------------------
 void Process::ArgumentList::add (const std::string& str)
 {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "vstgui/lib/optional.h"
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -16,17 +17,36 @@ namespace Vst {
 class Process
 {
 public:
+	struct ResourceUsage
+	{
+		/** seconds between start and exit of the child */
+		double wallTime {0.};
+		/** CPU time in seconds spent in user and kernel mode */
+		double userTime {0.};
+		double systemTime {0.};
+		/** peak resident set size in bytes, 0 if unknown */
+		int64_t maxResidentSetSize {0};
+	};
+
 	struct CallbackParams
 	{
 		bool isEOF {false};
+		/** exit status of the child, only valid when isEOF is true */
 		int resultCode {0};
+		/** stdout of the child. Platforms which cannot separate the streams also deliver stderr
+		 *  here */
 		std::vector<char> buffer;
+		std::vector<char> errorBuffer;
+		/** only valid when isEOF is true */
+		ResourceUsage resourceUsage;
 	};
 
 	struct ArgumentList
 	{
 		void add (const std::string& str);
 		void addPath (const std::string& str);
+		/** adds one -D<name>=<value> argument, platforms which build a command line quote it */
+		void addDefinition (const std::string& name, const std::string& value);
 
 		std::vector<std::string> args;
 	};
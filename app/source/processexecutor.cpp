@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "processexecutor.h"
+#include "vstgui/standalone/include/iasync.h"
+#include <algorithm>
+#include <thread>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+
+using namespace VSTGUI::Standalone;
+
+//------------------------------------------------------------------------
+bool ProcessExecutor::QueueOrder::operator() (const Entry& lhs, const Entry& rhs) const
+{
+	// std::push_heap/pop_heap build a max heap, so the entry which should run first must compare
+	// greater than all others
+	if (lhs.job.priority != rhs.job.priority)
+		return lhs.job.priority < rhs.job.priority;
+	return lhs.sequence > rhs.sequence;
+}
+
+//------------------------------------------------------------------------
+std::shared_ptr<ProcessExecutor> ProcessExecutor::create (uint32_t maxJobs)
+{
+	auto executor = std::make_shared<ProcessExecutor> ();
+	executor->setMaxJobs (maxJobs);
+	return executor;
+}
+
+//------------------------------------------------------------------------
+void ProcessExecutor::setMaxJobs (uint32_t numJobs)
+{
+	if (numJobs == 0)
+		numJobs = std::thread::hardware_concurrency ();
+	maxJobs = std::max (numJobs, 1u);
+	startQueuedJobs ();
+}
+
+//------------------------------------------------------------------------
+auto ProcessExecutor::submit (Job&& job) -> std::future<Result>
+{
+	Entry entry;
+	entry.job = std::move (job);
+	entry.sequence = nextSequence++;
+	auto future = entry.promise.get_future ();
+
+	queue.emplace_back (std::move (entry));
+	std::push_heap (queue.begin (), queue.end (), QueueOrder {});
+	startQueuedJobs ();
+	return future;
+}
+
+//------------------------------------------------------------------------
+void ProcessExecutor::cancelQueued ()
+{
+	auto cancelled = std::move (queue);
+	queue.clear ();
+	for (auto& entry : cancelled)
+		entry.promise.set_value ({});
+}
+
+//------------------------------------------------------------------------
+void ProcessExecutor::startQueuedJobs ()
+{
+	while (running.size () < maxJobs && !queue.empty ())
+	{
+		std::pop_heap (queue.begin (), queue.end (), QueueOrder {});
+		auto entry = std::move (queue.back ());
+		queue.pop_back ();
+		launch (std::move (entry));
+	}
+}
+
+//------------------------------------------------------------------------
+void ProcessExecutor::launch (Entry&& entry)
+{
+	auto sequence = entry.sequence;
+	auto promise = std::make_shared<std::promise<Result>> (std::move (entry.promise));
+	auto callback = std::move (entry.job.callback);
+	std::weak_ptr<ProcessExecutor> self = shared_from_this ();
+
+	auto process = Process::create (entry.job.path);
+	if (process)
+		running.emplace (sequence, process);
+	auto started =
+	    process && process->run (entry.job.arguments, [self, sequence, promise,
+	                                                   callback] (Process::CallbackParams& p) {
+		    if (callback)
+			    callback (p);
+		    if (!p.isEOF)
+			    return;
+		    Result result;
+		    result.started = true;
+		    result.resultCode = p.resultCode;
+		    result.resourceUsage = p.resourceUsage;
+		    promise->set_value (result);
+		    if (auto executor = self.lock ())
+			    executor->onJobFinished (sequence);
+	    });
+	if (started)
+		return;
+
+	running.erase (sequence);
+	if (callback)
+	{
+		Process::CallbackParams params;
+		params.isEOF = true;
+		params.resultCode = -1;
+		callback (params);
+	}
+	promise->set_value ({});
+}
+
+//------------------------------------------------------------------------
+void ProcessExecutor::onJobFinished (uint64_t sequence)
+{
+	auto it = running.find (sequence);
+	if (it != running.end ())
+	{
+		// we are called from within the callback of the process, so it must not be destroyed
+		// before the callback has returned
+		auto process = std::move (it->second);
+		running.erase (it);
+		Async::schedule (Async::mainQueue (), [process] () {});
+	}
+	startQueuedJobs ();
+}
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "process.h"
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+
+//------------------------------------------------------------------------
+/** Runs processes with a bounded number of concurrent children.
+ *
+ *	Jobs which cannot be started immediately are queued and started in priority order (higher
+ *	first, FIFO for equal priorities) as soon as a running job finishes.
+ *
+ *	The executor must be used from the main thread, the process callbacks are delivered there.
+ *	The returned futures may be waited on from other threads, but never from the main thread.
+ */
+class ProcessExecutor : public std::enable_shared_from_this<ProcessExecutor>
+{
+public:
+	struct Job
+	{
+		std::string path;
+		Process::ArgumentList arguments;
+		/** receives the output of the process and is called a last time with isEOF set */
+		Process::CallbackFunction callback;
+		int32_t priority {0};
+	};
+
+	struct Result
+	{
+		bool started {false};
+		int resultCode {-1};
+		Process::ResourceUsage resourceUsage;
+	};
+
+	/** maxJobs == 0 uses the number of hardware threads */
+	static std::shared_ptr<ProcessExecutor> create (uint32_t maxJobs = 0);
+
+	std::future<Result> submit (Job&& job);
+
+	/** removes all jobs which are not yet started, their futures report started == false */
+	void cancelQueued ();
+
+	void setMaxJobs (uint32_t maxJobs);
+	uint32_t getMaxJobs () const { return maxJobs; }
+	size_t getNumRunning () const { return running.size (); }
+	size_t getNumQueued () const { return queue.size (); }
+
+private:
+	struct Entry
+	{
+		Job job;
+		uint64_t sequence {0};
+		std::promise<Result> promise;
+	};
+	struct QueueOrder
+	{
+		bool operator() (const Entry& lhs, const Entry& rhs) const;
+	};
+
+	void startQueuedJobs ();
+	void launch (Entry&& entry);
+	void onJobFinished (uint64_t sequence);
+
+	uint32_t maxJobs {1};
+	uint64_t nextSequence {0};
+	std::vector<Entry> queue;
+	std::map<uint64_t, std::shared_ptr<Process>> running;
+};
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
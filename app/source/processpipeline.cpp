@@ -0,0 +1,161 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "processpipeline.h"
+#include <algorithm>
+#include <cassert>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+
+//------------------------------------------------------------------------
+std::shared_ptr<ProcessPipeline> ProcessPipeline::create (
+    const std::shared_ptr<ProcessExecutor>& executor)
+{
+	auto pipeline = std::make_shared<ProcessPipeline> ();
+	pipeline->executor = executor;
+	return pipeline;
+}
+
+//------------------------------------------------------------------------
+auto ProcessPipeline::addStep (const std::string& name, StepFunction&& func,
+                               const StepIDList& dependencies) -> StepID
+{
+	assert (!running);
+	// dependencies can only point to already added steps, this way there can be no cycles
+	assert (std::all_of (dependencies.begin (), dependencies.end (),
+	                     [&] (auto id) { return id < steps.size (); }));
+
+	Step step;
+	step.name = name;
+	step.func = std::move (func);
+	step.dependencies = dependencies;
+	steps.emplace_back (std::move (step));
+	return steps.size () - 1;
+}
+
+//------------------------------------------------------------------------
+auto ProcessPipeline::addProcessStep (const std::string& name, MakeJobFunction&& makeJob,
+                                      const StepIDList& dependencies) -> StepID
+{
+	return addStep (name, makeProcessStepFunction (std::move (makeJob)), dependencies);
+}
+
+//------------------------------------------------------------------------
+auto ProcessPipeline::makeProcessStepFunction (MakeJobFunction&& makeJob) const -> StepFunction
+{
+	std::weak_ptr<ProcessExecutor> weakExecutor = executor;
+	return [weakExecutor, makeJob] (DoneFunction&& done) {
+		auto executor = weakExecutor.lock ();
+		if (!executor)
+		{
+			done (false);
+			return;
+		}
+		auto job = makeJob ();
+		auto callback = std::move (job.callback);
+		job.callback = [callback, done] (Process::CallbackParams& p) {
+			if (callback)
+				callback (p);
+			if (p.isEOF)
+				done (p.resultCode == 0);
+		};
+		executor->submit (std::move (job));
+	};
+}
+
+//------------------------------------------------------------------------
+void ProcessPipeline::run (CompletionFunction&& completionFunc)
+{
+	assert (!running);
+	running = true;
+	completion = std::move (completionFunc);
+	startReadySteps ();
+}
+
+//------------------------------------------------------------------------
+auto ProcessPipeline::getStepState (StepID step) const -> StepState
+{
+	assert (step < steps.size ());
+	return steps[step].state;
+}
+
+//------------------------------------------------------------------------
+const std::string& ProcessPipeline::getStepName (StepID step) const
+{
+	assert (step < steps.size ());
+	return steps[step].name;
+}
+
+//------------------------------------------------------------------------
+void ProcessPipeline::startReadySteps ()
+{
+	auto self = shared_from_this ();
+	for (StepID id = 0; id < steps.size (); ++id)
+	{
+		auto& step = steps[id];
+		if (step.state != StepState::Waiting)
+			continue;
+		auto ready = std::all_of (
+		    step.dependencies.begin (), step.dependencies.end (),
+		    [&] (auto dependency) { return steps[dependency].state == StepState::Succeeded; });
+		if (!ready)
+			continue;
+		step.state = StepState::Running;
+		// a step may finish synchronously, which modifies the state of the other steps
+		auto func = step.func;
+		func ([self, id] (bool success) { self->onStepDone (id, success); });
+	}
+	if (running && isFinished ())
+	{
+		running = false;
+		auto success = std::all_of (steps.begin (), steps.end (), [] (const auto& step) {
+			return step.state == StepState::Succeeded;
+		});
+		auto completionFunc = std::move (completion);
+		if (completionFunc)
+			completionFunc (success);
+	}
+}
+
+//------------------------------------------------------------------------
+void ProcessPipeline::onStepDone (StepID step, bool success)
+{
+	assert (steps[step].state == StepState::Running);
+	steps[step].state = success ? StepState::Succeeded : StepState::Failed;
+	if (!success)
+		skipDependents (step);
+	startReadySteps ();
+}
+
+//------------------------------------------------------------------------
+void ProcessPipeline::skipDependents (StepID failedStep)
+{
+	// steps are sorted topologically, so a single forward pass reaches all indirect dependents
+	for (StepID id = failedStep + 1; id < steps.size (); ++id)
+	{
+		auto& step = steps[id];
+		if (step.state != StepState::Waiting)
+			continue;
+		auto skip =
+		    std::any_of (step.dependencies.begin (), step.dependencies.end (), [&] (auto dep) {
+			    return steps[dep].state == StepState::Failed ||
+			           steps[dep].state == StepState::Skipped;
+		    });
+		if (skip)
+			step.state = StepState::Skipped;
+	}
+}
+
+//------------------------------------------------------------------------
+bool ProcessPipeline::isFinished () const
+{
+	return std::none_of (steps.begin (), steps.end (), [] (const auto& step) {
+		return step.state == StepState::Waiting || step.state == StepState::Running;
+	});
+}
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "processexecutor.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+
+//------------------------------------------------------------------------
+/** A set of steps with explicit dependencies.
+ *
+ *	A step is started as soon as all steps it depends on have succeeded, so independent steps
+ *	run in parallel. When a step fails, all steps which depend on it (directly or indirectly)
+ *	are skipped, while unrelated steps still run to completion.
+ *
+ *	Like the ProcessExecutor, a pipeline must only be used from the main thread.
+ */
+class ProcessPipeline : public std::enable_shared_from_this<ProcessPipeline>
+{
+public:
+	using StepID = size_t;
+	using StepIDList = std::vector<StepID>;
+
+	enum class StepState
+	{
+		Waiting,
+		Running,
+		Succeeded,
+		Failed,
+		Skipped,
+	};
+
+	/** must be called exactly once by a step when it has finished */
+	using DoneFunction = std::function<void (bool success)>;
+	using StepFunction = std::function<void (DoneFunction&& done)>;
+	/** called when the step is started, the job succeeds if the process exits with 0 */
+	using MakeJobFunction = std::function<ProcessExecutor::Job ()>;
+	using CompletionFunction = std::function<void (bool success)>;
+
+	static std::shared_ptr<ProcessPipeline> create (
+	    const std::shared_ptr<ProcessExecutor>& executor);
+
+	StepID addStep (const std::string& name, StepFunction&& func,
+	                const StepIDList& dependencies = {});
+	StepID addProcessStep (const std::string& name, MakeJobFunction&& makeJob,
+	                       const StepIDList& dependencies = {});
+	/** the step function of addProcessStep, for steps which only run a process in some cases */
+	StepFunction makeProcessStepFunction (MakeJobFunction&& makeJob) const;
+
+	/** completion is called when no step is waiting or running anymore. success is only true if
+	 *  all steps succeeded */
+	void run (CompletionFunction&& completion);
+
+	StepState getStepState (StepID step) const;
+	const std::string& getStepName (StepID step) const;
+
+private:
+	struct Step
+	{
+		std::string name;
+		StepFunction func;
+		StepIDList dependencies;
+		StepState state {StepState::Waiting};
+	};
+
+	void startReadySteps ();
+	void onStepDone (StepID step, bool success);
+	void skipDependents (StepID step);
+	bool isFinished () const;
+
+	std::shared_ptr<ProcessExecutor> executor;
+	std::vector<Step> steps;
+	CompletionFunction completion;
+	bool running {false};
+};
+
+//------------------------------------------------------------------------
+} // Vst
+} // Steinberg
@@ -0,0 +1,100 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "projectsettings.h"
+#include <algorithm>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+size_t makeValidCppName (std::string& str, bool allowColon, char replaceChar)
+{
+	size_t replaced = 0;
+	char numericEndVal = allowColon ? 0x3B : 0x3A;
+	std::replace_if (str.begin (), str.end (),
+	                 [&] (auto c) {
+		                 // allowed: 0...9, A...Z and a...z
+		                 auto legal = (c >= 0x30 && c < numericEndVal) || (c >= 0x41 && c < 0x5B) ||
+		                              (c >= 0x61 && c < 0x7B) || c == replaceChar;
+		                 if (!legal)
+			                 replaced++;
+		                 return !legal;
+	                 },
+	                 replaceChar);
+	return replaced;
+}
+
+//------------------------------------------------------------------------
+GeneratorDefinitions makeGeneratorDefinitions (const ProjectSettings& settings)
+{
+	auto className = settings.className;
+	if (className.empty ())
+	{
+		className = settings.pluginName;
+		makeValidCppName (className);
+	}
+	auto cmakeProjectName = settings.pluginName;
+	makeValidCppName (cmakeProjectName);
+
+	auto quoted = [] (const std::string& str) { return "\"" + str + "\""; };
+
+	GeneratorDefinitions definitions;
+	definitions.emplace_back ("SMTG_VST3_SDK_SOURCE_DIR_CLI", quoted (settings.sdkPath));
+	definitions.emplace_back ("SMTG_GENERATOR_OUTPUT_DIRECTORY_CLI", quoted (settings.outputPath));
+	definitions.emplace_back ("SMTG_PLUGIN_NAME_CLI", quoted (settings.pluginName));
+	definitions.emplace_back ("SMTG_PLUGIN_CATEGORY_CLI", quoted (settings.pluginCategory));
+	definitions.emplace_back ("SMTG_CMAKE_PROJECT_NAME_CLI", quoted (cmakeProjectName));
+	definitions.emplace_back ("SMTG_PLUGIN_BUNDLE_NAME_CLI", quoted (settings.pluginName));
+	definitions.emplace_back ("SMTG_PLUGIN_IDENTIFIER_CLI", quoted (settings.bundleID));
+	if (!settings.macOSDeploymentTarget.empty ())
+		definitions.emplace_back ("SMTG_MACOS_DEPLOYMENT_TARGET_CLI",
+		                          quoted (settings.macOSDeploymentTarget));
+	definitions.emplace_back ("SMTG_VENDOR_NAME_CLI", quoted (settings.vendorName));
+	definitions.emplace_back ("SMTG_VENDOR_HOMEPAGE_CLI", quoted (settings.vendorHomepage));
+	definitions.emplace_back ("SMTG_VENDOR_EMAIL_CLI", quoted (settings.vendorEMail));
+	if (!settings.filenamePrefix.empty ())
+		definitions.emplace_back ("SMTG_PREFIX_FOR_FILENAMES_CLI", quoted (settings.filenamePrefix));
+	if (!settings.vendorNamespace.empty ())
+		definitions.emplace_back ("SMTG_VENDOR_NAMESPACE_CLI", quoted (settings.vendorNamespace));
+	if (!className.empty ())
+		definitions.emplace_back ("SMTG_PLUGIN_CLASS_NAME_CLI", quoted (className));
+	definitions.emplace_back ("SMTG_ENABLE_VSTGUI_SUPPORT_CLI", settings.useVSTGUI ? "ON" : "OFF");
+	if (settings.precompiledHeaders)
+		definitions.emplace_back ("SMTG_ENABLE_PRECOMPILED_HEADERS_CLI", "ON");
+	if (settings.unityBuild)
+		definitions.emplace_back ("SMTG_ENABLE_UNITY_BUILD_CLI", "ON");
+	if (!settings.sdkPrebuiltCachePath.empty ())
+		definitions.emplace_back ("SMTG_VST3_SDK_PREBUILT_CACHE_CLI",
+		                          quoted (settings.sdkPrebuiltCachePath));
+	if (!settings.compilerLauncher.empty ())
+		definitions.emplace_back ("SMTG_COMPILER_LAUNCHER_CLI", quoted (settings.compilerLauncher));
+	if (settings.deterministicUUIDs)
+		definitions.emplace_back ("SMTG_DETERMINISTIC_UUIDS_CLI", "ON");
+	if (!settings.uuidSeed.empty ())
+		definitions.emplace_back ("SMTG_UUID_SEED_CLI", quoted (settings.uuidSeed));
+	return definitions;
+}
+
+//------------------------------------------------------------------------
+GeneratorDefinitions makeConfigureDefinitions (const ProjectSettings& settings)
+{
+	GeneratorDefinitions definitions;
+	definitions.emplace_back ("SMTG_ENABLE_VSTGUI_SUPPORT", settings.useVSTGUI ? "ON" : "OFF");
+	// the cache entries of a reused build folder are not overwritten by the generated project
+	if (!settings.macOSDeploymentTarget.empty ())
+		definitions.emplace_back ("CMAKE_OSX_DEPLOYMENT_TARGET", settings.macOSDeploymentTarget);
+	definitions.emplace_back ("SMTG_VST3_SDK_PREBUILT_CACHE", settings.sdkPrebuiltCachePath);
+	// an empty launcher removes the one of a reused build folder
+	definitions.emplace_back ("SMTG_COMPILER_LAUNCHER", settings.compilerLauncher);
+	definitions.emplace_back ("CMAKE_C_COMPILER_LAUNCHER", settings.compilerLauncher);
+	definitions.emplace_back ("CMAKE_CXX_COMPILER_LAUNCHER", settings.compilerLauncher);
+	return definitions;
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "templateengine.h"
+#include <string>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** the inputs of a project, as entered in the window or read from a batch manifest */
+struct ProjectSettings
+{
+	std::string sdkPath;
+	/** folder of the SDK builds shared by all projects, empty to build the SDK in each project */
+	std::string sdkPrebuiltCachePath;
+	/** ccache or sccache executable which launches the compiler, empty to use none */
+	std::string compilerLauncher;
+	/** the project folder is created in this folder */
+	std::string outputPath;
+	std::string pluginName;
+	/** "Fx" or "Instrument" */
+	std::string pluginCategory {"Fx"};
+	std::string bundleID;
+	/** derived from the plug-in name if empty */
+	std::string className;
+	std::string filenamePrefix;
+	/** the default of the script if empty */
+	std::string macOSDeploymentTarget;
+	std::string vendorName;
+	std::string vendorHomepage;
+	std::string vendorEMail;
+	std::string vendorNamespace;
+	bool useVSTGUI {true};
+	/** the plug-in target precompiles the SDK headers, needs CMake 3.16 */
+	bool precompiledHeaders {false};
+	/** the plug-in target is a unity build, needs CMake 3.16 */
+	bool unityBuild {false};
+	/** derive the UUIDs from the uuidSeed, or from vendor, bundle ID and class name, instead of
+	 *  generating random ones */
+	bool deterministicUUIDs {false};
+	std::string uuidSeed;
+};
+
+//------------------------------------------------------------------------
+/** replaces all characters which are not allowed in a C++ identifier, returns the number of
+ *  replaced characters */
+size_t makeValidCppName (std::string& str, bool allowColon = false, char replaceChar = '_');
+
+/** the definitions for GenerateVST3Plugin.cmake and the native generator */
+GeneratorDefinitions makeGeneratorDefinitions (const ProjectSettings& settings);
+/** the cache definitions for configuring the generated project, the values are not quoted */
+GeneratorDefinitions makeConfigureDefinitions (const ProjectSettings& settings);
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
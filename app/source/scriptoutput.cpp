@@ -0,0 +1,264 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "scriptoutput.h"
+#include "filesystem.h"
+#include <algorithm>
+#include <cassert>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+constexpr uint32_t kFlushInterval = 16;
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+ScriptOutput::ScriptOutput ()
+{
+	lineStarts.emplace_back (0);
+}
+
+//------------------------------------------------------------------------
+ScriptOutput::~ScriptOutput () noexcept
+{
+	if (flushTimer)
+		flushTimer->stop ();
+}
+
+//------------------------------------------------------------------------
+void ScriptOutput::setBudget (size_t bytes, size_t lines)
+{
+	maxBytes = bytes;
+	maxLines = std::max<size_t> (lines, 1);
+	applyBudget ();
+}
+
+//------------------------------------------------------------------------
+void ScriptOutput::append (const char* data, size_t size)
+{
+	if (size == 0)
+		return;
+
+	++statistics.appends;
+	if (hasPendingDelta)
+	{
+		// the pending delta ends at the current end of the text
+		++statistics.mergedAppends;
+	}
+	else
+	{
+		pendingOffset = endOffset;
+		pendingFirstLine = droppedLines + lineStarts.size () - 1;
+		hasPendingDelta = true;
+		if (!flushTimer)
+			flushTimer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { flush (); },
+			                                      kFlushInterval, false);
+		flushTimer->start ();
+	}
+
+	if (transcript.is_open ())
+		transcript.write (data, size);
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		if (data[i] == '\n')
+			lineStarts.emplace_back (endOffset + i + 1);
+	}
+
+	while (size > 0)
+	{
+		// all chunks except the last one are completely filled, so the chunk of an offset can be
+		// calculated
+		if (chunks.empty () || chunks.back ().size () == kChunkSize)
+		{
+			chunks.emplace_back ();
+			chunks.back ().reserve (kChunkSize);
+		}
+		auto& chunk = chunks.back ();
+		auto numCopy = std::min (size, kChunkSize - chunk.size ());
+		chunk.append (data, numCopy);
+		data += numCopy;
+		size -= numCopy;
+		endOffset += numCopy;
+	}
+
+	applyBudget ();
+}
+
+//------------------------------------------------------------------------
+void ScriptOutput::applyBudget ()
+{
+	while (lineStarts.size () > 1 &&
+	       (lineStarts.size () > maxLines || endOffset - lineStarts.front () > maxBytes))
+	{
+		lineStarts.pop_front ();
+		++droppedLines;
+		++pendingDroppedLines;
+	}
+	while (!chunks.empty () && chunksOffset + kChunkSize <= lineStarts.front ())
+	{
+		chunks.pop_front ();
+		chunksOffset += kChunkSize;
+	}
+}
+
+//------------------------------------------------------------------------
+void ScriptOutput::flush ()
+{
+	if (flushTimer)
+		flushTimer->stop ();
+	if (transcript.is_open ())
+		transcript.flush ();
+	if (!hasPendingDelta)
+		return;
+	hasPendingDelta = false;
+	++statistics.flushes;
+
+	auto startOffset = lineStarts.front ();
+	auto offset = std::max (pendingOffset, startOffset);
+	Delta delta;
+	delta.offset = offset - startOffset;
+	delta.size = endOffset - offset;
+	delta.firstLine = std::max (pendingFirstLine, droppedLines) - droppedLines;
+	delta.droppedLines = pendingDroppedLines;
+	pendingDroppedLines = 0;
+
+	auto listenersCopy = listeners;
+	for (auto listener : listenersCopy)
+		listener->onScriptOutputAppended (*this, delta);
+}
+
+//------------------------------------------------------------------------
+void ScriptOutput::clear ()
+{
+	if (flushTimer)
+		flushTimer->stop ();
+	if (hasPendingDelta)
+	{
+		hasPendingDelta = false;
+		++statistics.droppedNotifications;
+	}
+	stopTranscript ();
+	transcriptPath.clear ();
+	chunks.clear ();
+	chunksOffset = 0;
+	lineStarts.clear ();
+	lineStarts.emplace_back (0);
+	endOffset = 0;
+	droppedLines = 0;
+	pendingDroppedLines = 0;
+
+	auto listenersCopy = listeners;
+	for (auto listener : listenersCopy)
+		listener->onScriptOutputCleared (*this);
+}
+
+//------------------------------------------------------------------------
+bool ScriptOutput::startTranscript (const std::string& path)
+{
+	stopTranscript ();
+	transcript.open (path, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!transcript.is_open ())
+		return false;
+	transcriptPath = path;
+	std::string text;
+	appendText (lineStarts.front (), endOffset, text);
+	transcript.write (text.data (), text.size ());
+	return true;
+}
+
+//------------------------------------------------------------------------
+void ScriptOutput::stopTranscript ()
+{
+	if (transcript.is_open ())
+		transcript.close ();
+}
+
+//------------------------------------------------------------------------
+std::string ScriptOutput::getLine (size_t index) const
+{
+	auto line = getText (lineStarts[index] - lineStarts.front (), getLineLength (index));
+	if (!line.empty () && line.back () == '\r')
+		line.pop_back ();
+	return line;
+}
+
+//------------------------------------------------------------------------
+size_t ScriptOutput::getLineLength (size_t index) const
+{
+	assert (index < lineStarts.size ());
+	auto end = index + 1 < lineStarts.size () ? lineStarts[index + 1] - 1 : endOffset;
+	return end - lineStarts[index];
+}
+
+//------------------------------------------------------------------------
+std::string ScriptOutput::getText (size_t offset, size_t size) const
+{
+	assert (offset + size <= getNumBytes ());
+	std::string result;
+	result.reserve (size);
+	offset += lineStarts.front ();
+	appendText (offset, offset + size, result);
+	return result;
+}
+
+//------------------------------------------------------------------------
+void ScriptOutput::appendText (size_t offset, size_t end, std::string& result) const
+{
+	while (offset < end)
+	{
+		const auto& chunk = chunks[(offset - chunksOffset) / kChunkSize];
+		auto chunkOffset = (offset - chunksOffset) % kChunkSize;
+		auto numCopy = std::min (end - offset, chunk.size () - chunkOffset);
+		result.append (chunk, chunkOffset, numCopy);
+		offset += numCopy;
+	}
+}
+
+//------------------------------------------------------------------------
+SharedPointer<IDataPackage> ScriptOutput::createClipboardData () const
+{
+	// the transcript file can be much larger, it is saved with saveTranscript instead
+	auto text = getText ();
+	return CDropSource::create (text.data (), static_cast<uint32_t> (text.size ()),
+	                            IDataPackage::Type::kText);
+}
+
+//------------------------------------------------------------------------
+bool ScriptOutput::saveTranscript (const std::string& path)
+{
+	if (transcriptPath.empty ())
+		return writeFile (path, getText ());
+	if (transcript.is_open ())
+		transcript.flush ();
+	return copyFile (transcriptPath, path);
+}
+
+//------------------------------------------------------------------------
+void ScriptOutput::registerListener (IListener* listener)
+{
+	listeners.emplace_back (listener);
+}
+
+//------------------------------------------------------------------------
+void ScriptOutput::unregisterListener (IListener* listener)
+{
+	auto it = std::find (listeners.begin (), listeners.end (), listener);
+	if (it != listeners.end ())
+		listeners.erase (it);
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
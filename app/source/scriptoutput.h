@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "vstgui/lib/cdropsource.h"
+#include "vstgui/lib/cvstguitimer.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** Text buffer for the output of the scripts.
+ *
+ *	The text is stored in fixed size chunks, so appending never moves already stored text and
+ *	costs O(appended bytes). A line index is updated on every append, so single lines can be
+ *	accessed without scanning the text.
+ *
+ *	Only the last lines within a byte and a line budget are kept in memory, older lines are
+ *	dropped. The complete output can be written to a transcript file.
+ *
+ *	Listeners are not notified for every append. Appends are merged into one delta which is
+ *	delivered at most once per display frame, or earlier when flush is called.
+ */
+class ScriptOutput
+{
+public:
+	struct Delta
+	{
+		/** byte offset and size of the appended text */
+		size_t offset {0};
+		size_t size {0};
+		/** the first line which was changed, the appended text may continue the previous last
+		 *  line */
+		size_t firstLine {0};
+		/** number of lines dropped at the front since the last notification */
+		size_t droppedLines {0};
+	};
+
+	struct Statistics
+	{
+		uint64_t appends {0};
+		/** appends which were merged into an already pending notification */
+		uint64_t mergedAppends {0};
+		/** pending notifications which were dropped because the output was cleared */
+		uint64_t droppedNotifications {0};
+		uint64_t flushes {0};
+	};
+
+	struct IListener
+	{
+		virtual void onScriptOutputAppended (const ScriptOutput& output, const Delta& delta) = 0;
+		virtual void onScriptOutputCleared (const ScriptOutput& output) = 0;
+	};
+
+	static constexpr size_t kDefaultMaxBytes = 8 * 1024 * 1024;
+	static constexpr size_t kDefaultMaxLines = 100000;
+
+	ScriptOutput ();
+	~ScriptOutput () noexcept;
+
+	/** the last line is always kept, even if it exceeds the byte budget */
+	void setBudget (size_t maxBytes, size_t maxLines);
+
+	void append (const char* data, size_t size);
+	void append (const std::string& str) { append (str.data (), str.size ()); }
+	/** clears the text and stops the transcript */
+	void clear ();
+	/** notify the listeners about pending appends now */
+	void flush ();
+
+	/** writes the text kept in memory and all following appends to the file */
+	bool startTranscript (const std::string& path);
+	void stopTranscript ();
+	/** the path of the current or last transcript, empty if there is none */
+	const std::string& getTranscriptPath () const { return transcriptPath; }
+
+	/** offsets and line indices are relative to the text kept in memory */
+	size_t getNumBytes () const { return endOffset - lineStarts.front (); }
+	/** a text ending with a newline has an empty last line */
+	size_t getNumLines () const { return lineStarts.size (); }
+	/** without the line ending */
+	std::string getLine (size_t index) const;
+	/** in bytes, including a trailing carriage return */
+	size_t getLineLength (size_t index) const;
+	std::string getText (size_t offset, size_t size) const;
+	std::string getText () const { return getText (0, getNumBytes ()); }
+
+	/** clipboard data of the text kept in memory */
+	VSTGUI::SharedPointer<VSTGUI::IDataPackage> createClipboardData () const;
+	/** copies the transcript file if there is one, otherwise writes the text kept in memory */
+	bool saveTranscript (const std::string& path);
+
+	void registerListener (IListener* listener);
+	void unregisterListener (IListener* listener);
+
+	const Statistics& getStatistics () const { return statistics; }
+	void resetStatistics () { statistics = {}; }
+
+private:
+	static constexpr size_t kChunkSize = 64 * 1024;
+
+	void applyBudget ();
+	void appendText (size_t offset, size_t size, std::string& result) const;
+
+	// all offsets are absolute offsets since the last clear
+	std::deque<std::string> chunks;
+	size_t chunksOffset {0};
+	std::deque<size_t> lineStarts;
+	size_t endOffset {0};
+	size_t maxBytes {kDefaultMaxBytes};
+	size_t maxLines {kDefaultMaxLines};
+
+	std::ofstream transcript;
+	std::string transcriptPath;
+
+	std::vector<IListener*> listeners;
+	VSTGUI::SharedPointer<VSTGUI::CVSTGUITimer> flushTimer;
+	size_t pendingOffset {0};
+	size_t pendingFirstLine {0};
+	size_t pendingDroppedLines {0};
+	size_t droppedLines {0};
+	bool hasPendingDelta {false};
+	Statistics statistics;
+};
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
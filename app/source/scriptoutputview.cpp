@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "scriptoutputview.h"
+#include "vstgui/lib/cdrawcontext.h"
+#include <algorithm>
+#include <cmath>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+ScriptOutputView::ScriptOutputView (const CRect& size,
+                                    const std::shared_ptr<ScriptOutput>& scriptOutput)
+: CView (size), scriptOutput (scriptOutput), font (kNormalFontSmall), minWidth (size.getWidth ())
+{
+	updateLineMetrics ();
+	for (size_t line = 0; line < scriptOutput->getNumLines (); ++line)
+		maxLineLength = std::max (maxLineLength, scriptOutput->getLineLength (line));
+	scriptOutput->registerListener (this);
+}
+
+//------------------------------------------------------------------------
+ScriptOutputView::~ScriptOutputView () noexcept
+{
+	scriptOutput->unregisterListener (this);
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::setFont (CFontRef newFont)
+{
+	font = newFont;
+	updateLineMetrics ();
+	updateViewSize ();
+	invalid ();
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::setFontColor (const CColor& color)
+{
+	fontColor = color;
+	invalid ();
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::setBackColor (const CColor& color)
+{
+	backColor = color;
+	invalid ();
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::setTextInset (const CPoint& inset)
+{
+	textInset = inset;
+	updateViewSize ();
+	invalid ();
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::updateLineMetrics ()
+{
+	// the script output font is a monospaced one, so the advance of a character is a fixed part
+	// of the font size
+	lineHeight = std::ceil (font->getSize () * 1.25);
+	charWidth = font->getSize () * 0.6;
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::updateViewSize ()
+{
+	auto height = scriptOutput->getNumLines () * lineHeight + textInset.y * 2.;
+	auto width = std::max (minWidth, std::ceil (maxLineLength * charWidth + textInset.x * 2.));
+	auto r = getViewSize ();
+	if (r.getHeight () == height && r.getWidth () == width)
+		return;
+	r.setHeight (height);
+	r.setWidth (width);
+	// the parent scroll view adapts its container size to the new view size
+	setViewSize (r);
+	setMouseableArea (r);
+}
+
+//------------------------------------------------------------------------
+auto ScriptOutputView::getLineRect (size_t line) const -> CRect
+{
+	CRect r (getViewSize ());
+	r.left += textInset.x;
+	r.right -= textInset.x;
+	r.top += textInset.y + line * lineHeight;
+	r.setHeight (lineHeight);
+	return r;
+}
+
+//------------------------------------------------------------------------
+bool ScriptOutputView::attached (CView* parent)
+{
+	if (!CView::attached (parent))
+		return false;
+	// the size from the description only defines the minimum width
+	updateViewSize ();
+	return true;
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::draw (CDrawContext* context)
+{
+	drawRect (context, getViewSize ());
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::drawRect (CDrawContext* context, const CRect& updateRect)
+{
+	context->setFillColor (backColor);
+	context->drawRect (updateRect, kDrawFilled);
+
+	auto numLines = scriptOutput->getNumLines ();
+	auto top = updateRect.top - getViewSize ().top - textInset.y;
+	auto bottom = updateRect.bottom - getViewSize ().top - textInset.y;
+	auto firstLine = static_cast<size_t> (std::max (0., std::floor (top / lineHeight)));
+	auto lastLine =
+	    std::min (numLines, static_cast<size_t> (std::max (0., std::ceil (bottom / lineHeight))));
+
+	context->setFont (font);
+	context->setFontColor (fontColor);
+	for (auto line = firstLine; line < lastLine; ++line)
+	{
+		if (scriptOutput->getLineLength (line) == 0)
+			continue;
+		context->drawString (UTF8String (scriptOutput->getLine (line)), getLineRect (line),
+		                     kLeftText);
+	}
+	setDirty (false);
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::onScriptOutputAppended (const ScriptOutput& output,
+                                               const ScriptOutput::Delta& delta)
+{
+	auto numLines = output.getNumLines ();
+	for (auto line = delta.firstLine; line < numLines; ++line)
+		maxLineLength = std::max (maxLineLength, output.getLineLength (line));
+	updateViewSize ();
+
+	if (delta.droppedLines > 0)
+	{
+		// all lines moved up
+		invalid ();
+		return;
+	}
+	auto r = getLineRect (delta.firstLine);
+	r.bottom = getLineRect (numLines - 1).bottom;
+	r.left = getViewSize ().left;
+	r.right = getViewSize ().right;
+	invalidRect (r);
+}
+
+//------------------------------------------------------------------------
+void ScriptOutputView::onScriptOutputCleared (const ScriptOutput& output)
+{
+	maxLineLength = 0;
+	updateViewSize ();
+	invalid ();
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
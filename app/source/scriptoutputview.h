@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "scriptoutput.h"
+#include "vstgui/lib/ccolor.h"
+#include "vstgui/lib/cfont.h"
+#include "vstgui/lib/cview.h"
+#include <memory>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** Shows the lines of a ScriptOutput buffer.
+ *
+ *	Lines are not wrapped and have a fixed height, so the view size is known without a text
+ *	layout and only the lines intersecting the dirty rect are drawn. The view resizes itself to
+ *	fit the text, it is meant to be the single child of a CScrollView.
+ */
+class ScriptOutputView : public VSTGUI::CView,
+                         public ScriptOutput::IListener
+{
+public:
+	using CRect = VSTGUI::CRect;
+	using CPoint = VSTGUI::CPoint;
+	using CColor = VSTGUI::CColor;
+	using CCoord = VSTGUI::CCoord;
+	using CFontRef = VSTGUI::CFontRef;
+	using CDrawContext = VSTGUI::CDrawContext;
+
+	ScriptOutputView (const CRect& size, const std::shared_ptr<ScriptOutput>& scriptOutput);
+	~ScriptOutputView () noexcept override;
+
+	void setFont (CFontRef font);
+	void setFontColor (const CColor& color);
+	void setBackColor (const CColor& color);
+	void setTextInset (const CPoint& inset);
+
+	CCoord getLineHeight () const { return lineHeight; }
+
+	bool attached (CView* parent) override;
+	void draw (CDrawContext* context) override;
+	void drawRect (CDrawContext* context, const CRect& updateRect) override;
+
+	void onScriptOutputAppended (const ScriptOutput& output,
+	                             const ScriptOutput::Delta& delta) override;
+	void onScriptOutputCleared (const ScriptOutput& output) override;
+
+private:
+	void updateLineMetrics ();
+	void updateViewSize ();
+	CRect getLineRect (size_t line) const;
+
+	std::shared_ptr<ScriptOutput> scriptOutput;
+	VSTGUI::SharedPointer<VSTGUI::CFontDesc> font;
+	CColor fontColor {VSTGUI::kBlackCColor};
+	CColor backColor {VSTGUI::kWhiteCColor};
+	CPoint textInset {5., 2.};
+	CCoord lineHeight {12.};
+	CCoord charWidth {6.};
+	CCoord minWidth {0.};
+	size_t maxLineLength {0};
+};
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
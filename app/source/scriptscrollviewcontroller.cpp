@@ -2,12 +2,13 @@
 // Flags       : clang-format SMTGSequencer
 
 #include "scriptscrollviewcontroller.h"
-#include "vstgui/lib/cdropsource.h"
+#include "scriptoutputview.h"
+#include "vstgui/lib/cfileselector.h"
 #include "vstgui/lib/cframe.h"
 #include "vstgui/lib/controls/coptionmenu.h"
-#include "vstgui/lib/controls/ctextlabel.h"
 #include "vstgui/lib/cscrollview.h"
-#include "vstgui/standalone/include/helpers/value.h"
+#include "vstgui/uidescription/iuidescription.h"
+#include "vstgui/uidescription/uiattributes.h"
 
 //------------------------------------------------------------------------
 namespace Steinberg {
@@ -15,88 +16,121 @@ namespace Vst {
 namespace ProjectCreator {
 
 using namespace VSTGUI;
-using namespace VSTGUI::Standalone;
 
 //------------------------------------------------------------------------
-ScriptScrollViewController::ScriptScrollViewController (IController* parent, ValuePtr value)
-: ValueListenerViewController (parent, value)
+ScriptScrollViewController::ScriptScrollViewController (IController* parent,
+                                                        const ScriptOutputPtr& scriptOutput)
+: DelegationController (parent), scriptOutput (scriptOutput)
 {
 }
 
+//------------------------------------------------------------------------
+auto ScriptScrollViewController::createView (const UIAttributes& attributes,
+                                             const IUIDescription* description) -> CView*
+{
+	auto name = attributes.getAttributeValue (IUIDescription::kCustomViewName);
+	if (!name || *name != "ScriptOutputView")
+		return controller->createView (attributes, description);
+
+	CPoint size;
+	attributes.getPointAttribute ("size", size);
+	auto view = new ScriptOutputView (CRect (0, 0, size.x, size.y), scriptOutput);
+	if (auto fontName = attributes.getAttributeValue ("font"))
+	{
+		if (auto font = description->getFont (fontName->data ()))
+			view->setFont (font);
+	}
+	CColor color;
+	if (auto colorName = attributes.getAttributeValue ("font-color"))
+	{
+		if (description->getColor (colorName->data (), color))
+			view->setFontColor (color);
+	}
+	if (auto colorName = attributes.getAttributeValue ("back-color"))
+	{
+		if (description->getColor (colorName->data (), color))
+			view->setBackColor (color);
+	}
+	CPoint inset;
+	if (attributes.getPointAttribute ("text-inset", inset))
+		view->setTextInset (inset);
+	outputView = view;
+	outputView->registerViewListener (this);
+	return view;
+}
+
 //------------------------------------------------------------------------
 auto ScriptScrollViewController::verifyView (CView* view, const UIAttributes& attributes,
                                              const IUIDescription* description) -> CView*
 {
 	if (auto sv = dynamic_cast<CScrollView*> (view))
-	{
 		scrollView = sv;
-		if (auto label = dynamic_cast<CMultiLineTextLabel*> (scrollView->getView (0)))
-		{
-			label->registerViewListener (this);
-		}
-	}
 	return controller->verifyView (view, attributes, description);
 }
 
 //------------------------------------------------------------------------
 void ScriptScrollViewController::scrollToBottom ()
 {
-	if (!scrollView)
+	if (!scrollView || !outputView)
 		return;
-	auto containerSize = scrollView->getContainerSize ();
-	containerSize.top = containerSize.bottom - 10;
-	scrollView->makeRectVisible (containerSize);
+	auto r = outputView->getViewSize ();
+	r.top = r.bottom - outputView->getLineHeight ();
+	scrollView->makeRectVisible (r);
 }
 
 //------------------------------------------------------------------------
-void ScriptScrollViewController::onEndEdit (IValue&)
+void ScriptScrollViewController::viewSizeChanged (CView* view, const CRect& oldSize)
 {
-	scrollToBottom ();
+	if (view == outputView)
+		scrollToBottom ();
 }
 
 //------------------------------------------------------------------------
 void ScriptScrollViewController::viewWillDelete (CView* view)
 {
-	if (auto label = dynamic_cast<CMultiLineTextLabel*> (view))
-		label->unregisterViewListener (this);
+	if (view == outputView)
+	{
+		outputView->unregisterViewListener (this);
+		outputView = nullptr;
+	}
 }
 
 //------------------------------------------------------------------------
 void ScriptScrollViewController::viewAttached (CView* view)
 {
-	if (auto label = dynamic_cast<CMultiLineTextLabel*> (view))
-	{
-		if (label->getAutoHeight ())
-		{
-			label->setAutoHeight (false);
-			label->setAutoHeight (true);
-		}
-		label->unregisterViewListener (this);
+	if (view == outputView)
 		scrollToBottom ();
-	}
 }
 
 //------------------------------------------------------------------------
 void ScriptScrollViewController::appendContextMenuItems (COptionMenu& contextMenu, CView* view,
                                                          const CPoint& where)
 {
-	if (auto stringValue = getValue ()->dynamicCast<IStringValue> ())
-	{
-		if (stringValue->getString ().empty ())
+	if (scriptOutput->getNumBytes () == 0)
+		return;
+	auto commandItem = new CCommandMenuItem ({"Copy text to clipboard"});
+	commandItem->setActions ([&, output = scriptOutput] (CCommandMenuItem*) {
+		auto frame = contextMenu.getFrame ();
+		if (!frame)
 			return;
-		auto commandItem = new CCommandMenuItem ({"Copy text to clipboard"});
-		commandItem->setActions ([&, stringValue] (CCommandMenuItem*) {
-			auto frame = contextMenu.getFrame ();
-			if (!frame)
+		frame->setClipboard (output->createClipboardData ());
+	});
+	contextMenu.addEntry (commandItem);
+	auto saveItem = new CCommandMenuItem ({"Save transcript..."});
+	saveItem->setActions ([&, output = scriptOutput] (CCommandMenuItem*) {
+		auto fileSelector = owned (
+		    CNewFileSelector::create (contextMenu.getFrame (), CNewFileSelector::kSelectSaveFile));
+		if (!fileSelector)
+			return;
+		fileSelector->setTitle ("Save transcript");
+		fileSelector->setDefaultSaveName ("project_generator.log");
+		fileSelector->run ([output] (CNewFileSelector* fs) {
+			if (fs->getNumSelectedFiles () == 0)
 				return;
-			auto data =
-			    CDropSource::create (stringValue->getString ().data (),
-			                         static_cast<uint32_t> (stringValue->getString ().length ()),
-			                         IDataPackage::Type::kText);
-			frame->setClipboard (data);
+			output->saveTranscript (fs->getSelectedFile (0).getString ());
 		});
-		contextMenu.addEntry (commandItem);
-	}
+	});
+	contextMenu.addEntry (saveItem);
 }
 
 //------------------------------------------------------------------------
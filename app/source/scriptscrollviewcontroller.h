@@ -3,36 +3,42 @@
 
 #pragma once
 
-#include "valuelistenerviewcontroller.h"
+#include "scriptoutput.h"
 #include "vstgui/lib/iviewlistener.h"
+#include "vstgui/uidescription/delegationcontroller.h"
+#include <memory>
 
 //------------------------------------------------------------------------
 namespace Steinberg {
 namespace Vst {
 namespace ProjectCreator {
 
+class ScriptOutputView;
+
 //------------------------------------------------------------------------
-class ScriptScrollViewController : public ValueListenerViewController,
+class ScriptScrollViewController : public VSTGUI::DelegationController,
                                    public VSTGUI::ViewListenerAdapter,
                                    public VSTGUI::IContextMenuController2
 {
 public:
 	using CView = VSTGUI::CView;
+	using CRect = VSTGUI::CRect;
 	using UIAttributes = VSTGUI::UIAttributes;
 	using IUIDescription = VSTGUI::IUIDescription;
-	using IValue = VSTGUI::Standalone::IValue;
 	using COptionMenu = VSTGUI::COptionMenu;
 	using CPoint = VSTGUI::CPoint;
 	using CScrollView = VSTGUI::CScrollView;
+	using ScriptOutputPtr = std::shared_ptr<ScriptOutput>;
 
-	ScriptScrollViewController (IController* parent, ValuePtr value);
+	ScriptScrollViewController (IController* parent, const ScriptOutputPtr& scriptOutput);
 
+	CView* createView (const UIAttributes& attributes, const IUIDescription* description) override;
 	CView* verifyView (CView* view, const UIAttributes& attributes,
 	                   const IUIDescription* description) override;
 
 	void scrollToBottom ();
 
-	void onEndEdit (IValue&) override;
+	void viewSizeChanged (CView* view, const CRect& oldSize) override;
 
 	void viewWillDelete (CView* view) override;
 
@@ -42,7 +48,9 @@ public:
 	                             const CPoint& where) override;
 
 private:
+	ScriptOutputPtr scriptOutput;
 	CScrollView* scrollView {nullptr};
+	ScriptOutputView* outputView {nullptr};
 };
 
 //------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "sha1.h"
+#include <algorithm>
+#include <cstring>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+inline uint32_t rotateLeft (uint32_t value, uint32_t bits)
+{
+	return (value << bits) | (value >> (32 - bits));
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+SHA1::SHA1 () : state {{0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0}}
+{
+}
+
+//------------------------------------------------------------------------
+void SHA1::update (const void* data, size_t size)
+{
+	auto bytes = static_cast<const uint8_t*> (data);
+	numBytes += size;
+	if (bufferSize > 0)
+	{
+		auto numCopy = std::min (size, buffer.size () - bufferSize);
+		memcpy (buffer.data () + bufferSize, bytes, numCopy);
+		bufferSize += numCopy;
+		bytes += numCopy;
+		size -= numCopy;
+		if (bufferSize < buffer.size ())
+			return;
+		processBlock (buffer.data ());
+		bufferSize = 0;
+	}
+	for (; size >= buffer.size (); bytes += buffer.size (), size -= buffer.size ())
+		processBlock (bytes);
+	memcpy (buffer.data (), bytes, size);
+	bufferSize = size;
+}
+
+//------------------------------------------------------------------------
+auto SHA1::finish () -> Digest
+{
+	auto numBits = numBytes * 8;
+	uint8_t padding[72] = {0x80};
+	auto paddingSize = (bufferSize < 56 ? 56 : 120) - bufferSize;
+	for (auto i = 0; i < 8; ++i)
+		padding[paddingSize + i] = static_cast<uint8_t> (numBits >> (56 - i * 8));
+	update (padding, paddingSize + 8);
+
+	Digest digest;
+	for (size_t i = 0; i < digest.size (); ++i)
+		digest[i] = static_cast<uint8_t> (state[i / 4] >> (24 - (i % 4) * 8));
+	return digest;
+}
+
+//------------------------------------------------------------------------
+void SHA1::processBlock (const uint8_t* block)
+{
+	uint32_t w[80];
+	for (auto i = 0; i < 16; ++i)
+		w[i] = (static_cast<uint32_t> (block[i * 4]) << 24) |
+		       (static_cast<uint32_t> (block[i * 4 + 1]) << 16) |
+		       (static_cast<uint32_t> (block[i * 4 + 2]) << 8) | block[i * 4 + 3];
+	for (auto i = 16; i < 80; ++i)
+		w[i] = rotateLeft (w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+	auto a = state[0];
+	auto b = state[1];
+	auto c = state[2];
+	auto d = state[3];
+	auto e = state[4];
+	for (auto i = 0; i < 80; ++i)
+	{
+		uint32_t f, k;
+		if (i < 20)
+		{
+			f = (b & c) | (~b & d);
+			k = 0x5A827999;
+		}
+		else if (i < 40)
+		{
+			f = b ^ c ^ d;
+			k = 0x6ED9EBA1;
+		}
+		else if (i < 60)
+		{
+			f = (b & c) | (b & d) | (c & d);
+			k = 0x8F1BBCDC;
+		}
+		else
+		{
+			f = b ^ c ^ d;
+			k = 0xCA62C1D6;
+		}
+		auto temp = rotateLeft (a, 5) + f + e + k + w[i];
+		e = d;
+		d = c;
+		c = rotateLeft (b, 30);
+		b = a;
+		a = temp;
+	}
+	state[0] += a;
+	state[1] += b;
+	state[2] += c;
+	state[3] += d;
+	state[4] += e;
+}
+
+//------------------------------------------------------------------------
+auto SHA1::calculate (const std::string& str) -> Digest
+{
+	SHA1 sha1;
+	sha1.update (str);
+	return sha1.finish ();
+}
+
+//------------------------------------------------------------------------
+std::string SHA1::toString (const Digest& digest)
+{
+	static constexpr auto hexDigits = "0123456789abcdef";
+	std::string result;
+	result.reserve (digest.size () * 2);
+	for (auto byte : digest)
+	{
+		result += hexDigits[byte >> 4];
+		result += hexDigits[byte & 0x0F];
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
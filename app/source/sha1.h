@@ -0,0 +1,46 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** SHA-1 as used by string(UUID ... TYPE SHA1) of CMake */
+class SHA1
+{
+public:
+	using Digest = std::array<uint8_t, 20>;
+
+	SHA1 ();
+
+	void update (const void* data, size_t size);
+	void update (const std::string& str) { update (str.data (), str.size ()); }
+	/** the object must not be updated afterwards */
+	Digest finish ();
+
+	static Digest calculate (const std::string& str);
+	/** lower case hex string */
+	static std::string toString (const Digest& digest);
+
+private:
+	void processBlock (const uint8_t* block);
+
+	std::array<uint32_t, 5> state;
+	std::array<uint8_t, 64> buffer;
+	size_t bufferSize {0};
+	uint64_t numBytes {0};
+};
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
@@ -0,0 +1,411 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "templatecache.h"
+#include "include/rapidjson/document.h"
+#include "include/rapidjson/stringbuffer.h"
+#include "include/rapidjson/writer.h"
+#include "sha1.h"
+#include "uuid.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+// characters allowed in @VAR@ references by configure_file
+constexpr auto VariableNameChars =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789/_.+-";
+constexpr auto CacheFormatVersion = 2;
+
+using CompiledTemplateSetPtr = std::shared_ptr<CompiledTemplateSet>;
+
+//------------------------------------------------------------------------
+struct TemplateCompiler
+{
+	CompiledTemplate result;
+
+	void addLiteral (const char* data, size_t size)
+	{
+		if (size == 0)
+			return;
+		auto& segments = result.segments;
+		if (segments.empty () || segments.back ().variable >= 0)
+		{
+			CompiledTemplate::Segment segment;
+			segment.offset = result.text.size ();
+			segments.emplace_back (segment);
+		}
+		result.text.append (data, size);
+		segments.back ().size += size;
+	}
+
+	void addVariable (std::string&& name)
+	{
+		auto& names = result.variableNames;
+		auto it = std::find (names.begin (), names.end (), name);
+		if (it == names.end ())
+			it = names.emplace (names.end (), std::move (name));
+		CompiledTemplate::Segment segment;
+		segment.variable = static_cast<int32_t> (std::distance (names.begin (), it));
+		result.segments.emplace_back (segment);
+	}
+
+	void addLine (const char* line, const char* end)
+	{
+		while (line < end)
+		{
+			auto at = static_cast<const char*> (memchr (line, '@', end - line));
+			if (!at)
+				break;
+			auto nameStart = at + 1;
+			auto nameEnd = nameStart;
+			while (nameEnd < end && strchr (VariableNameChars, *nameEnd))
+				++nameEnd;
+			// only a non empty name directly followed by '@' is a variable reference
+			if (nameEnd < end && *nameEnd == '@' && nameEnd != nameStart)
+			{
+				addLiteral (line, at - line);
+				addVariable (std::string (nameStart, nameEnd));
+				line = nameEnd + 1;
+			}
+			else
+			{
+				addLiteral (line, nameStart - line);
+				line = nameStart;
+			}
+		}
+		addLiteral (line, end - line);
+		// LF, the last line is terminated as well
+		addLiteral ("\n", 1);
+	}
+};
+
+//------------------------------------------------------------------------
+bool matchesFiles (const CompiledTemplateSet& set, const std::string& directory,
+                   const std::vector<std::string>& paths,
+                   const std::vector<FileIdentity>& identities)
+{
+	if (set.directory != directory || set.files.size () != paths.size ())
+		return false;
+	for (size_t i = 0; i < paths.size (); ++i)
+	{
+		if (set.files[i].path != paths[i] || set.files[i].identity != identities[i])
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+CompiledTemplateSetPtr loadCompiledTemplates (const std::string& cacheFile)
+{
+	using namespace rapidjson;
+
+	auto json = readFile (cacheFile);
+	if (!json)
+		return nullptr;
+
+	// rapidjson asserts on a wrong type, so every value is checked before it is read and a file
+	// which does not match the format is treated like a missing cache
+	Document doc;
+	doc.Parse (json->data (), json->size ());
+	if (!doc.IsObject () || !doc.HasMember ("version") || !doc.HasMember ("directory") ||
+	    !doc.HasMember ("hash") || !doc.HasMember ("files") || !doc["files"].IsArray () ||
+	    !doc["version"].IsInt () || doc["version"].GetInt () != CacheFormatVersion ||
+	    !doc["directory"].IsString () || !doc["hash"].IsString ())
+		return nullptr;
+	auto set = std::make_shared<CompiledTemplateSet> ();
+	set->directory = doc["directory"].GetString ();
+	set->contentHash = doc["hash"].GetString ();
+	for (const auto& file : doc["files"].GetArray ())
+	{
+		if (!file.IsObject () || !file.HasMember ("path") || !file.HasMember ("size") ||
+		    !file.HasMember ("mtime") || !file.HasMember ("id") || !file.HasMember ("sha1") ||
+		    !file.HasMember ("compiled") || !file["path"].IsString () || !file["size"].IsInt64 () ||
+		    !file["mtime"].IsInt64 () || !file["id"].IsUint64 () || !file["sha1"].IsString () ||
+		    !file["compiled"].IsBool ())
+			return nullptr;
+		CompiledTemplateSet::File f;
+		f.path = file["path"].GetString ();
+		f.identity.size = file["size"].GetInt64 ();
+		f.identity.modificationTime = file["mtime"].GetInt64 ();
+		f.identity.fileID = file["id"].GetUint64 ();
+		f.hash = file["sha1"].GetString ();
+		f.compiled = file["compiled"].GetBool ();
+		if (f.compiled)
+		{
+			if (!file.HasMember ("text") || !file.HasMember ("variables") ||
+			    !file.HasMember ("segments") || !file["text"].IsString () ||
+			    !file["variables"].IsArray () || !file["segments"].IsArray () ||
+			    file["segments"].Size () % 3 != 0)
+				return nullptr;
+			auto& content = f.content;
+			const auto& text = file["text"];
+			content.text.assign (text.GetString (), text.GetStringLength ());
+			for (const auto& name : file["variables"].GetArray ())
+			{
+				if (!name.IsString ())
+					return nullptr;
+				content.variableNames.emplace_back (name.GetString ());
+			}
+			const auto& segments = file["segments"];
+			for (SizeType i = 0; i < segments.Size (); i += 3)
+			{
+				if (!segments[i].IsUint64 () || !segments[i + 1].IsUint64 () ||
+				    !segments[i + 2].IsInt ())
+					return nullptr;
+				CompiledTemplate::Segment segment;
+				segment.offset = segments[i].GetUint64 ();
+				segment.size = segments[i + 1].GetUint64 ();
+				segment.variable = segments[i + 2].GetInt ();
+				if (segment.variable < 0 ? segment.offset + segment.size > content.text.size ()
+				                         : static_cast<size_t> (segment.variable) >=
+				                               content.variableNames.size ())
+					return nullptr;
+				content.segments.emplace_back (segment);
+			}
+		}
+		set->files.emplace_back (std::move (f));
+	}
+	return set;
+}
+
+//------------------------------------------------------------------------
+bool storeCompiledTemplates (const std::string& cacheFile, const CompiledTemplateSet& set)
+{
+	using namespace rapidjson;
+
+	StringBuffer buffer;
+	Writer<StringBuffer> writer (buffer);
+	writer.StartObject ();
+	writer.Key ("version");
+	writer.Int (CacheFormatVersion);
+	writer.Key ("directory");
+	writer.String (set.directory.data (), static_cast<SizeType> (set.directory.size ()));
+	writer.Key ("hash");
+	writer.String (set.contentHash.data (), static_cast<SizeType> (set.contentHash.size ()));
+	writer.Key ("files");
+	writer.StartArray ();
+	for (const auto& file : set.files)
+	{
+		writer.StartObject ();
+		writer.Key ("path");
+		writer.String (file.path.data (), static_cast<SizeType> (file.path.size ()));
+		writer.Key ("size");
+		writer.Int64 (file.identity.size);
+		writer.Key ("mtime");
+		writer.Int64 (file.identity.modificationTime);
+		writer.Key ("id");
+		writer.Uint64 (file.identity.fileID);
+		writer.Key ("sha1");
+		writer.String (file.hash.data (), static_cast<SizeType> (file.hash.size ()));
+		writer.Key ("compiled");
+		writer.Bool (file.compiled);
+		if (file.compiled)
+		{
+			const auto& content = file.content;
+			writer.Key ("text");
+			writer.String (content.text.data (), static_cast<SizeType> (content.text.size ()));
+			writer.Key ("variables");
+			writer.StartArray ();
+			for (const auto& name : content.variableNames)
+				writer.String (name.data (), static_cast<SizeType> (name.size ()));
+			writer.EndArray ();
+			// offset, size and variable of each segment
+			writer.Key ("segments");
+			writer.StartArray ();
+			for (const auto& segment : content.segments)
+			{
+				writer.Uint64 (segment.offset);
+				writer.Uint64 (segment.size);
+				writer.Int (segment.variable);
+			}
+			writer.EndArray ();
+		}
+		writer.EndObject ();
+	}
+	writer.EndArray ();
+	writer.EndObject ();
+
+	// other generators may read or write the cache at the same time, so it is replaced at once
+	auto tempFile = cacheFile + "." + makeRandomString (8) + ".tmp";
+	if (!writeFile (tempFile, std::string (buffer.GetString (), buffer.GetSize ())))
+	{
+		removeFile (tempFile);
+		return false;
+	}
+	if (!renamePath (tempFile, cacheFile))
+	{
+		removeFile (tempFile);
+		return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+Optional<CompiledTemplate> CompiledTemplate::compile (const std::string& input)
+{
+	static const std::string cmakeDefine = "#cmakedefine";
+
+	TemplateCompiler compiler;
+	auto pos = input.data ();
+	auto end = pos + input.size ();
+	while (pos < end)
+	{
+		auto lineEnd = static_cast<const char*> (memchr (pos, '\n', end - pos));
+		if (!lineEnd)
+			lineEnd = end;
+		auto contentEnd = lineEnd;
+		if (contentEnd > pos && *(contentEnd - 1) == '\r')
+			--contentEnd;
+		if (std::search (pos, contentEnd, cmakeDefine.begin (), cmakeDefine.end ()) != contentEnd)
+			return {};
+		compiler.addLine (pos, contentEnd);
+		pos = lineEnd + 1;
+	}
+	return {std::move (compiler.result)};
+}
+
+//------------------------------------------------------------------------
+void CompiledTemplate::render (const TemplateVariables& variables, ByteRangeList& ranges) const
+{
+	static const std::string empty;
+
+	std::vector<const std::string*> values;
+	values.reserve (variableNames.size ());
+	for (const auto& name : variableNames)
+	{
+		auto it = variables.find (name);
+		values.emplace_back (it != variables.end () ? &it->second : &empty);
+	}
+	ranges.clear ();
+	ranges.reserve (segments.size ());
+	for (const auto& segment : segments)
+	{
+		if (segment.variable < 0)
+			ranges.push_back ({text.data () + segment.offset, segment.size});
+		else
+		{
+			const auto& value = *values[segment.variable];
+			ranges.push_back ({value.data (), value.size ()});
+		}
+	}
+}
+
+//------------------------------------------------------------------------
+std::string CompiledTemplate::render (const TemplateVariables& variables) const
+{
+	ByteRangeList ranges;
+	render (variables, ranges);
+	std::string result;
+	for (const auto& range : ranges)
+		result.append (range.data, range.size);
+	return result;
+}
+
+//------------------------------------------------------------------------
+bool hasTemplateExtension (const std::string& path)
+{
+	auto nameStart = path.find_last_of ('/');
+	auto name = path.substr (nameStart == std::string::npos ? 0 : nameStart + 1);
+	auto extensionStart = name.find_last_of ('.');
+	return extensionStart != std::string::npos && name.substr (extensionStart) == ".in";
+}
+
+//------------------------------------------------------------------------
+std::shared_ptr<const CompiledTemplateSet> getCompiledTemplates (const std::string& directory,
+                                                                 const std::string& cacheFile)
+{
+	static std::mutex mutex;
+	static std::map<std::string, CompiledTemplateSetPtr> memoryCache;
+
+	std::vector<std::string> paths;
+	if (!listFilesRecursive (directory, paths))
+		return nullptr;
+	std::vector<FileIdentity> identities;
+	identities.reserve (paths.size ());
+	for (const auto& path : paths)
+	{
+		auto identity = getFileIdentity (directory + "/" + path);
+		if (!identity)
+			return nullptr;
+		identities.emplace_back (*identity);
+	}
+
+	std::lock_guard<std::mutex> guard (mutex);
+	auto& cached = memoryCache[directory];
+	if (cached && matchesFiles (*cached, directory, paths, identities))
+		return cached;
+
+	auto stored = cacheFile.empty () ? nullptr : loadCompiledTemplates (cacheFile);
+	if (stored && matchesFiles (*stored, directory, paths, identities))
+	{
+		cached = stored;
+		return cached;
+	}
+
+	auto set = std::make_shared<CompiledTemplateSet> ();
+	set->directory = directory;
+	SHA1 sha1;
+	std::vector<std::string> contents;
+	for (size_t i = 0; i < paths.size (); ++i)
+	{
+		auto content = readFile (directory + "/" + paths[i]);
+		if (!content)
+			return nullptr;
+		auto size = std::to_string (content->size ());
+		sha1.update (paths[i].data (), paths[i].size () + 1);
+		sha1.update (size.data (), size.size () + 1);
+		sha1.update (*content);
+
+		CompiledTemplateSet::File file;
+		file.path = paths[i];
+		file.identity = identities[i];
+		file.hash = SHA1::toString (SHA1::calculate (*content));
+		contents.emplace_back (std::move (*content));
+		file.compiled = hasTemplateExtension (paths[i]);
+		set->files.emplace_back (std::move (file));
+	}
+	set->contentHash = SHA1::toString (sha1.finish ());
+
+	// only the identities changed, e.g. after a checkout
+	auto reuseStored = stored && stored->contentHash == set->contentHash &&
+	                   stored->directory == directory && stored->files.size () == paths.size ();
+	for (size_t i = 0; i < set->files.size (); ++i)
+	{
+		auto& file = set->files[i];
+		if (!file.compiled)
+			continue;
+		if (reuseStored && stored->files[i].compiled)
+		{
+			file.content = std::move (stored->files[i].content);
+			continue;
+		}
+		auto compiled = CompiledTemplate::compile (contents[i]);
+		if (!compiled)
+			return nullptr;
+		file.content = std::move (*compiled);
+	}
+
+	if (!cacheFile.empty ())
+		storeCompiledTemplates (cacheFile, *set);
+	cached = set;
+	return cached;
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "filesystem.h"
+#include "vstgui/lib/optional.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+using TemplateVariables = std::map<std::string, std::string>;
+
+//------------------------------------------------------------------------
+/** A template tokenized into literal spans and variable slots.
+ *
+ *	The line endings are already converted like configure_file (... @ONLY LF) does, so rendering
+ *	only collects the spans and the values of the variables.
+ */
+class CompiledTemplate
+{
+public:
+	struct Segment
+	{
+		/** span in text if variable is negative */
+		size_t offset {0};
+		size_t size {0};
+		/** index in variableNames */
+		int32_t variable {-1};
+	};
+
+	/** nothing if the template uses #cmakedefine, which is not supported */
+	static VSTGUI::Optional<CompiledTemplate> compile (const std::string& input);
+
+	/** the ranges point into this template and into the variables */
+	void render (const TemplateVariables& variables, ByteRangeList& ranges) const;
+	std::string render (const TemplateVariables& variables) const;
+
+	std::string text;
+	std::vector<std::string> variableNames;
+	std::vector<Segment> segments;
+};
+
+//------------------------------------------------------------------------
+struct CompiledTemplateSet
+{
+	struct File
+	{
+		/** relative to the template folder with '/' as separator */
+		std::string path;
+		FileIdentity identity;
+		/** SHA-1 of the content */
+		std::string hash;
+		/** only ".in" files are compiled, all others are copied */
+		bool compiled {false};
+		CompiledTemplate content;
+	};
+
+	std::string directory;
+	/** SHA-1 of the paths and contents of all files */
+	std::string contentHash;
+	std::vector<File> files;
+};
+
+//------------------------------------------------------------------------
+/** the ".in" files of the folder are compiled once and kept in memory and in the cache file,
+ *  which may be empty. Changed templates are detected by their file identity and only
+ *  recompiled if the content hash changed. Returns nullptr if the folder cannot be read or a
+ *  template cannot be compiled. Thread safe. */
+std::shared_ptr<const CompiledTemplateSet> getCompiledTemplates (const std::string& directory,
+                                                                 const std::string& cacheFile);
+
+/** the last extension of the file name is ".in" */
+bool hasTemplateExtension (const std::string& path);
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
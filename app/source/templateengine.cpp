@@ -0,0 +1,889 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "templateengine.h"
+#include "filesystem.h"
+#include "include/rapidjson/document.h"
+#include "include/rapidjson/stringbuffer.h"
+#include "include/rapidjson/writer.h"
+#include "sha1.h"
+#include "uuid.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+// UUID DNS namespace generated at Steinberg
+constexpr auto UUIDNamespace = "ed66da11-5014-4e8a-876d-829007337274";
+constexpr auto ManifestFileName = ".project_generator_manifest.json";
+constexpr auto StagingDirectoryPrefix = ".project_generator_staging_";
+constexpr auto TemporaryFileSuffix = ".project_generator_tmp";
+constexpr auto ManifestFormatVersion = 1;
+
+//------------------------------------------------------------------------
+const std::string& getVariable (const TemplateVariables& variables, const std::string& name)
+{
+	static const std::string empty;
+	auto it = variables.find (name);
+	return it != variables.end () ? it->second : empty;
+}
+
+//------------------------------------------------------------------------
+void replaceAll (std::string& str, const std::string& match, const std::string& replace)
+{
+	size_t pos = 0;
+	while ((pos = str.find (match, pos)) != std::string::npos)
+	{
+		str.replace (pos, match.size (), replace);
+		pos += replace.size ();
+	}
+}
+
+//------------------------------------------------------------------------
+/** a false constant of if (<variable>) */
+bool isCMakeOff (std::string value)
+{
+	std::transform (value.begin (), value.end (), value.begin (),
+	                [] (char c) { return static_cast<char> (std::toupper (c)); });
+	static const char* falseConstants[] = {"", "0", "OFF", "NO", "FALSE", "N", "IGNORE", "NOTFOUND"};
+	for (auto constant : falseConstants)
+	{
+		if (value == constant)
+			return true;
+	}
+	static const std::string notFoundSuffix = "-NOTFOUND";
+	return value.size () >= notFoundSuffix.size () &&
+	       value.compare (value.size () - notFoundSuffix.size (), notFoundSuffix.size (),
+	                      notFoundSuffix) == 0;
+}
+
+//------------------------------------------------------------------------
+std::string getCurrentYear ()
+{
+	// string (TIMESTAMP) uses SOURCE_DATE_EPOCH for reproducible outputs
+	auto now = std::time (nullptr);
+	if (auto epoch = std::getenv ("SOURCE_DATE_EPOCH"))
+	{
+		char* end = nullptr;
+		auto value = std::strtoll (epoch, &end, 10);
+		if (end != epoch && *end == 0)
+			now = static_cast<std::time_t> (value);
+	}
+	std::tm local {};
+#if WINDOWS
+	localtime_s (&local, &now);
+#else
+	localtime_r (&now, &local);
+#endif
+	return std::to_string (local.tm_year + 1900);
+}
+
+//------------------------------------------------------------------------
+void addUUID (TemplateVariables& variables, const std::string& prefix, const std::string& name)
+{
+	auto uuid = makeSHA1UUID (UUIDNamespace, name);
+	uuid.erase (std::remove (uuid.begin (), uuid.end (), '-'), uuid.end ());
+
+	std::string parts[4];
+	for (auto i = 0; i < 4; ++i)
+	{
+		parts[i] = uuid.substr (i * 8, 8);
+		variables["SMTG_" + prefix + "_UUID_PART_" + std::to_string (i)] = parts[i];
+	}
+	variables["SMTG_" + prefix + "_UUID"] =
+	    "0x" + parts[0] + ", 0x" + parts[1] + ", 0x" + parts[2] + ", 0x" + parts[3];
+	variables["SMTG_" + prefix + "_PLAIN_UUID"] = uuid;
+}
+
+//------------------------------------------------------------------------
+bool isFileContent (const std::string& path, const ByteRangeList& ranges)
+{
+	auto existing = readFile (path);
+	if (!existing)
+		return false;
+	size_t offset = 0;
+	for (const auto& range : ranges)
+	{
+		if (existing->compare (offset, range.size, range.data, range.size) != 0)
+			return false;
+		offset += range.size;
+	}
+	return offset == existing->size ();
+}
+
+//------------------------------------------------------------------------
+/** the generated files of the last generation, relative to the output directory */
+struct Manifest
+{
+	struct Entry
+	{
+		std::string hash;
+		/** of the file after it was written, to detect modifications */
+		FileIdentity identity;
+	};
+
+	TemplateVariables uuids;
+	std::map<std::string, Entry> files;
+};
+
+//------------------------------------------------------------------------
+bool isUUIDVariable (const std::string& name)
+{
+	return name.compare (0, 15, "SMTG_Processor_") == 0 ||
+	       name.compare (0, 16, "SMTG_Controller_") == 0;
+}
+
+//------------------------------------------------------------------------
+Optional<Manifest> loadManifest (const std::string& path)
+{
+	using namespace rapidjson;
+
+	auto json = readFile (path);
+	if (!json)
+		return {};
+
+	// rapidjson asserts on a wrong type, so every value is checked before it is read and a file
+	// which does not match the format is treated like a missing manifest
+	Document doc;
+	doc.Parse (json->data (), json->size ());
+	if (!doc.IsObject () || !doc.HasMember ("version") || !doc.HasMember ("uuids") ||
+	    !doc.HasMember ("files") || !doc["version"].IsInt () ||
+	    doc["version"].GetInt () != ManifestFormatVersion || !doc["uuids"].IsObject () ||
+	    !doc["files"].IsObject ())
+		return {};
+	Manifest manifest;
+	for (const auto& uuid : doc["uuids"].GetObject ())
+	{
+		if (!uuid.value.IsString ())
+			return {};
+		if (isUUIDVariable (uuid.name.GetString ()))
+			manifest.uuids[uuid.name.GetString ()] = uuid.value.GetString ();
+	}
+	for (const auto& file : doc["files"].GetObject ())
+	{
+		const auto& value = file.value;
+		if (!value.IsObject () || !value.HasMember ("sha1") || !value.HasMember ("size") ||
+		    !value.HasMember ("mtime") || !value.HasMember ("id") || !value["sha1"].IsString () ||
+		    !value["size"].IsInt64 () || !value["mtime"].IsInt64 () || !value["id"].IsUint64 ())
+			return {};
+		Manifest::Entry entry;
+		entry.hash = value["sha1"].GetString ();
+		entry.identity.size = value["size"].GetInt64 ();
+		entry.identity.modificationTime = value["mtime"].GetInt64 ();
+		entry.identity.fileID = value["id"].GetUint64 ();
+		manifest.files[file.name.GetString ()] = std::move (entry);
+	}
+	return {std::move (manifest)};
+}
+
+//------------------------------------------------------------------------
+bool storeManifest (const std::string& path, const Manifest& manifest)
+{
+	using namespace rapidjson;
+
+	StringBuffer buffer;
+	Writer<StringBuffer> writer (buffer);
+	writer.StartObject ();
+	writer.Key ("version");
+	writer.Int (ManifestFormatVersion);
+	writer.Key ("uuids");
+	writer.StartObject ();
+	for (const auto& uuid : manifest.uuids)
+	{
+		writer.Key (uuid.first.data (), static_cast<SizeType> (uuid.first.size ()));
+		writer.String (uuid.second.data (), static_cast<SizeType> (uuid.second.size ()));
+	}
+	writer.EndObject ();
+	writer.Key ("files");
+	writer.StartObject ();
+	for (const auto& file : manifest.files)
+	{
+		writer.Key (file.first.data (), static_cast<SizeType> (file.first.size ()));
+		writer.StartObject ();
+		writer.Key ("sha1");
+		writer.String (file.second.hash.data (), static_cast<SizeType> (file.second.hash.size ()));
+		writer.Key ("size");
+		writer.Int64 (file.second.identity.size);
+		writer.Key ("mtime");
+		writer.Int64 (file.second.identity.modificationTime);
+		writer.Key ("id");
+		writer.Uint64 (file.second.identity.fileID);
+		writer.EndObject ();
+	}
+	writer.EndObject ();
+	writer.EndObject ();
+
+	return writeFile (path, std::string (buffer.GetString (), buffer.GetSize ()));
+}
+
+//------------------------------------------------------------------------
+std::string calculateHash (const ByteRangeList& ranges)
+{
+	SHA1 sha1;
+	for (const auto& range : ranges)
+		sha1.update (range.data, range.size);
+	return SHA1::toString (sha1.finish ());
+}
+
+//------------------------------------------------------------------------
+enum class EmitResult
+{
+	Written,
+	Unchanged,
+	Failed,
+};
+
+//------------------------------------------------------------------------
+/** the first copy of each copied template file written by this process */
+class CopiedFiles
+{
+public:
+	static CopiedFiles& instance ()
+	{
+		static CopiedFiles copiedFiles;
+		return copiedFiles;
+	}
+
+	/** a copy with the content which was not modified since it was written */
+	Optional<std::string> find (const std::string& hash)
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		auto it = files.find (hash);
+		if (it == files.end ())
+			return {};
+		auto identity = getFileIdentity (it->second.path);
+		if (!identity || *identity != it->second.identity)
+		{
+			files.erase (it);
+			return {};
+		}
+		return {std::string (it->second.path)};
+	}
+
+	void add (const std::string& hash, const std::string& path, const FileIdentity& identity)
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		files.emplace (hash, File {path, identity});
+	}
+
+private:
+	struct File
+	{
+		std::string path;
+		FileIdentity identity;
+	};
+
+	std::mutex mutex;
+	std::map<std::string, File> files;
+};
+
+//------------------------------------------------------------------------
+/** like configure_file, an unchanged file keeps its modification time */
+bool isUnchanged (const std::string& outputPath, const Manifest::Entry* previous,
+                  Manifest::Entry& entry, const std::function<bool ()>& compareContent)
+{
+	auto identity = getFileIdentity (outputPath);
+	if (!identity)
+		return false;
+	// a file which was not modified since the last generation does not need to be read
+	auto unchanged = previous && previous->identity == *identity ? previous->hash == entry.hash
+	                                                             : compareContent ();
+	if (unchanged)
+		entry.identity = *identity;
+	return unchanged;
+}
+
+//------------------------------------------------------------------------
+EmitResult copyTemplateFile (const CompiledTemplateSet::File& templateFile,
+                             const std::string& inputPath, const std::string& outputPath,
+                             const std::string& writePath, bool linkCopiedFiles,
+                             const Manifest::Entry* previous, Manifest::Entry& entry,
+                             std::string& error)
+{
+	entry.hash = templateFile.hash;
+	if (isUnchanged (outputPath, previous, entry, [&] () {
+		    auto existing = readFile (outputPath);
+		    return existing && SHA1::toString (SHA1::calculate (*existing)) == entry.hash;
+	    }))
+		return EmitResult::Unchanged;
+
+	auto linked = false;
+	if (linkCopiedFiles)
+	{
+		// falls back to a copy if the first copy is on another volume
+		if (auto firstCopy = CopiedFiles::instance ().find (entry.hash))
+			linked = linkFile (*firstCopy, writePath);
+	}
+	if (!linked && !copyFile (inputPath, writePath))
+	{
+		error = "Could not copy " + inputPath + " to " + outputPath;
+		return EmitResult::Failed;
+	}
+	if (auto newIdentity = getFileIdentity (writePath))
+		entry.identity = *newIdentity;
+	return EmitResult::Written;
+}
+
+//------------------------------------------------------------------------
+/** outputPath is the final path of the file, the file is written to writePath */
+EmitResult emitFile (const CompiledTemplateSet::File& templateFile, const TemplateFile& file,
+                     const TemplateVariables& variables, const GeneratorOptions& options,
+                     const std::string& inputPath, const std::string& outputPath,
+                     const std::string& writePath, const Manifest::Entry* previous,
+                     Manifest::Entry& entry, std::string& error)
+{
+	// copied files are not read, the kernel copies or clones them
+	if (!file.configure)
+		return copyTemplateFile (templateFile, inputPath, outputPath, writePath,
+		                         options.linkCopiedFiles, previous, entry, error);
+
+	// a prefix or plug-in name can change the extension of the output file, in this case the
+	// template is used as it is
+	ByteRangeList ranges;
+	std::string content;
+	if (templateFile.compiled)
+		templateFile.content.render (variables, ranges);
+	else
+	{
+		auto input = readFile (inputPath);
+		auto configured = input ? configureTemplate (*input, variables) : Optional<std::string> ();
+		if (!configured)
+		{
+			error = "Could not configure " + inputPath;
+			return EmitResult::Failed;
+		}
+		content = std::move (*configured);
+		ranges = {{content.data (), content.size ()}};
+	}
+	entry.hash = calculateHash (ranges);
+	if (isUnchanged (outputPath, previous, entry,
+	                 [&] () { return isFileContent (outputPath, ranges); }))
+		return EmitResult::Unchanged;
+	if (!writeFile (writePath, ranges))
+	{
+		error = "Could not write " + outputPath;
+		return EmitResult::Failed;
+	}
+	if (auto newIdentity = getFileIdentity (writePath))
+		entry.identity = *newIdentity;
+	return EmitResult::Written;
+}
+
+//------------------------------------------------------------------------
+/** calls func for each index on a number of threads */
+void parallelFor (size_t count, const std::function<void (size_t index)>& func)
+{
+	auto numThreads = std::min<size_t> (std::max (std::thread::hardware_concurrency (), 1u), count);
+	std::atomic<size_t> nextIndex {0};
+	auto worker = [&] () {
+		for (auto index = nextIndex++; index < count; index = nextIndex++)
+			func (index);
+	};
+	std::vector<std::future<void>> threads;
+	for (size_t i = 1; i < numThreads; ++i)
+		threads.emplace_back (std::async (std::launch::async, worker));
+	worker ();
+	for (auto& thread : threads)
+		thread.get ();
+}
+
+//------------------------------------------------------------------------
+/** the files of the shared SDK build are only generated for projects which use it */
+bool isTemplateUsed (const std::string& path, const TemplateVariables& variables)
+{
+	static const std::string prebuiltFolder = "vst3plugin_folder/cmake/";
+	if (path.compare (0, prebuiltFolder.size (), prebuiltFolder) != 0)
+		return true;
+	return !isCMakeOff (getVariable (variables, "SMTG_VST3_SDK_PREBUILT_CACHE"));
+}
+
+//------------------------------------------------------------------------
+/** file (STRINGS <path> <variable>), the lines of the file without the empty ones */
+std::vector<std::string> readLines (const std::string& path)
+{
+	std::vector<std::string> lines;
+	auto content = readFile (path);
+	if (!content)
+		return lines;
+	size_t pos = 0;
+	while (pos < content->size ())
+	{
+		auto end = content->find ('\n', pos);
+		if (end == std::string::npos)
+			end = content->size ();
+		auto line = content->substr (pos, end - pos);
+		if (!line.empty () && line.back () == '\r')
+			line.pop_back ();
+		if (!line.empty ())
+			lines.emplace_back (std::move (line));
+		pos = end + 1;
+	}
+	return lines;
+}
+
+//------------------------------------------------------------------------
+/** the set (<NAME> <value>) commands at the top level of a module of the script, so the defaults
+ *  are only defined by the script. The value is a quoted string or one argument, both can
+ *  reference variables. The overrides of the module are indented and applied by the caller */
+void readModuleDefaults (const std::string& path, TemplateVariables& variables)
+{
+	static const std::string command = "set(";
+	for (const auto& line : readLines (path))
+	{
+		if (line.compare (0, command.size (), command) != 0 || line.back () != ')')
+			continue;
+		auto arguments = line.substr (command.size (), line.size () - command.size () - 1);
+		auto separator = arguments.find (' ');
+		if (separator == std::string::npos)
+			continue;
+		auto value = arguments.substr (separator + 1);
+		if (value.size () >= 2 && value.front () == '"' && value.back () == '"')
+			value = value.substr (1, value.size () - 2);
+		size_t pos = 0;
+		while ((pos = value.find ("${", pos)) != std::string::npos)
+		{
+			auto end = value.find ('}', pos);
+			if (end == std::string::npos)
+				break;
+			const auto& reference = getVariable (variables, value.substr (pos + 2, end - pos - 2));
+			value.replace (pos, end + 1 - pos, reference);
+			pos += reference.size ();
+		}
+		variables[arguments.substr (0, separator)] = value;
+	}
+}
+
+//------------------------------------------------------------------------
+/** file (READ <path> <variable>) and string (CONFIGURE ... @ONLY) */
+std::string configureSnippet (const std::string& path, const TemplateVariables& variables)
+{
+	auto content = readFile (path);
+	if (!content)
+		return {};
+	auto snippet = CompiledTemplate::compile (*content);
+	if (!snippet)
+		return {};
+	return snippet->render (variables);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TemplateVariables makeTemplateVariables (const GeneratorDefinitions& definitions,
+                                         const std::string& scriptDir)
+{
+	TemplateVariables variables;
+
+	// if (<NAME>_CLI) string (REPLACE "\"" "" <NAME> ${<NAME>_CLI})
+	auto applyDefinition = [&] (const std::string& name) {
+		auto it = std::find_if (definitions.rbegin (), definitions.rend (),
+		                        [&] (const auto& def) { return def.first == name + "_CLI"; });
+		if (it == definitions.rend () || isCMakeOff (it->second))
+			return false;
+		auto value = it->second;
+		// the unquoted expansion splits the value at semicolons and string (REPLACE) joins the
+		// parts again
+		value.erase (std::remove_if (value.begin (), value.end (),
+		                             [] (char c) { return c == '"' || c == ';'; }),
+		             value.end ());
+		variables[name] = value;
+		return true;
+	};
+
+	// GenerateVST3Plugin.cmake
+	auto& scriptDirVar = variables["SMTG_CMAKE_SCRIPT_DIR"];
+	scriptDirVar = scriptDir;
+	while (scriptDirVar.size () > 1 && (scriptDirVar.back () == '/' || scriptDirVar.back () == '\\'))
+		scriptDirVar.pop_back ();
+	applyDefinition ("SMTG_CMAKE_SCRIPT_DIR");
+	auto scriptDirStr = variables["SMTG_CMAKE_SCRIPT_DIR"];
+	auto modulesPath = scriptDirStr + "/cmake/modules";
+
+	// SMTG_GeneratorSpecifics.cmake
+	readModuleDefaults (modulesPath + "/SMTG_GeneratorSpecifics.cmake", variables);
+	for (auto name : {"SMTG_GENERATOR_OUTPUT_DIRECTORY", "SMTG_TEMPLATE_FILES_PATH",
+	                  "SMTG_VST3_SDK_SOURCE_DIR", "SMTG_VST3_SDK_PREBUILT_CACHE",
+	                  "SMTG_COMPILER_LAUNCHER"})
+		applyDefinition (name);
+	for (auto name : {"SMTG_ENABLE_VSTGUI_SUPPORT", "SMTG_ENABLE_PRECOMPILED_HEADERS",
+	                  "SMTG_ENABLE_UNITY_BUILD"})
+	{
+		// set (<NAME> ${<NAME>_CLI}), without removing the quotes
+		auto cliName = std::string (name) + "_CLI";
+		for (const auto& def : definitions)
+		{
+			if (def.first == cliName && !isCMakeOff (def.second))
+				variables[name] = def.second;
+		}
+	}
+
+	// SMTG_VendorSpecifics.cmake
+	variables["SMTG_CURRENT_YEAR"] = getCurrentYear ();
+	readModuleDefaults (modulesPath + "/SMTG_VendorSpecifics.cmake", variables);
+	for (auto name :
+	     {"SMTG_VENDOR_NAME", "SMTG_VENDOR_HOMEPAGE", "SMTG_VENDOR_EMAIL", "SMTG_PLUGIN_NAME",
+	      "SMTG_PREFIX_FOR_FILENAMES", "SMTG_PLUGIN_IDENTIFIER", "SMTG_PLUGIN_CLASS_NAME",
+	      "SMTG_VENDOR_NAMESPACE", "SMTG_PLUGIN_CATEGORY", "SMTG_PLUGIN_BUNDLE_NAME"})
+		applyDefinition (name);
+	if (!applyDefinition ("SMTG_CMAKE_PROJECT_NAME"))
+		variables["SMTG_CMAKE_PROJECT_NAME"] = variables["SMTG_PLUGIN_BUNDLE_NAME"];
+	applyDefinition ("SMTG_MACOS_DEPLOYMENT_TARGET");
+	variables["SMTG_SOURCE_COPYRIGHT_HEADER"] =
+	    "Copyright(c) " + variables["SMTG_CURRENT_YEAR"] + " " + variables["SMTG_VENDOR_NAME"] + ".";
+
+	// SMTG_CodeSnippets.cmake
+	if (variables["SMTG_PLUGIN_CATEGORY"].find ("Instrument") != std::string::npos)
+		variables["SMTG_EFFECT_INPUT_AUDIO_BUSSES_CODE_SNIPPET"] =
+		    "// addAudioInput (STR16 (\"Stereo In\"), Steinberg::Vst::SpeakerArr::kStereo);";
+	else
+		variables["SMTG_EFFECT_INPUT_AUDIO_BUSSES_CODE_SNIPPET"] =
+		    "addAudioInput (STR16 (\"Stereo In\"), Steinberg::Vst::SpeakerArr::kStereo);";
+	variables["SMTG_EFFECT_OUTPUT_AUDIO_BUSSES_CODE_SNIPPET"] =
+	    "addAudioOutput (STR16 (\"Stereo Out\"), Steinberg::Vst::SpeakerArr::kStereo);";
+	variables["SMTG_EFFECT_EVENT_BUSSES_CODE_SNIPPET"] =
+	    "/* If you don't need an event bus, you can remove the next line */\n"
+	    "\taddEventInput (STR16 (\"Event In\"), 1);";
+	if (!isCMakeOff (variables["SMTG_ENABLE_VSTGUI_SUPPORT"]))
+	{
+		variables["SMTG_INCLUDE_VSTGUI_HEADER_CODE_SNIPPET"] =
+		    "#include \"vstgui/plugin-bindings/vst3editor.h\"";
+		variables["SMTG_CREATE_VSTGUI_EDITOR_CODE_SNIPPET"] =
+		    "// create your editor here and return a IPlugView ptr of it\n"
+		    "\t\tauto* view = new VSTGUI::VST3Editor (this, \"view\", \"" +
+		    variables["SMTG_PREFIX_FOR_FILENAMES"] +
+		    "editor.uidesc\");\n"
+		    "\t\treturn view;";
+	}
+	else
+	{
+		variables["SMTG_CREATE_VSTGUI_EDITOR_CODE_SNIPPET"] =
+		    "// create your editor here and return a IPlugView ptr of it\n"
+		    "        return nullptr;";
+	}
+	auto snippetsPath = scriptDirStr + "/cmake/snippets";
+	std::string buildOptions;
+	if (!isCMakeOff (variables["SMTG_ENABLE_PRECOMPILED_HEADERS"]))
+	{
+		auto headers = readLines (snippetsPath + "/precompiled_headers.txt");
+		if (!isCMakeOff (variables["SMTG_ENABLE_VSTGUI_SUPPORT"]))
+		{
+			for (auto& header : readLines (snippetsPath + "/precompiled_headers_vstgui.txt"))
+				headers.emplace_back (std::move (header));
+		}
+		auto& headerList = variables["SMTG_PRECOMPILED_HEADERS"];
+		for (const auto& header : headers)
+			headerList += (headerList.empty () ? "" : "\n            ") + header;
+		buildOptions += configureSnippet (snippetsPath + "/precompiled_headers.cmake.in", variables);
+	}
+	if (!isCMakeOff (variables["SMTG_ENABLE_UNITY_BUILD"]))
+		buildOptions += configureSnippet (snippetsPath + "/unity_build.cmake.in", variables);
+	variables["SMTG_TARGET_BUILD_OPTIONS_CODE_SNIPPET"] = std::move (buildOptions);
+
+	// SMTG_GeneratePluginUuids.cmake
+	readModuleDefaults (modulesPath + "/SMTG_GeneratePluginUuids.cmake", variables);
+	for (const auto& def : definitions)
+	{
+		if (def.first == "SMTG_DETERMINISTIC_UUIDS_CLI" && !isCMakeOff (def.second))
+			variables["SMTG_DETERMINISTIC_UUIDS"] = def.second;
+	}
+	if (applyDefinition ("SMTG_UUID_SEED"))
+		variables["SMTG_DETERMINISTIC_UUIDS"] = "ON";
+	if (!isCMakeOff (variables["SMTG_DETERMINISTIC_UUIDS"]))
+	{
+		auto name = variables["SMTG_UUID_SEED"];
+		if (name.empty ())
+			name = variables["SMTG_VENDOR_NAME"] + "|" + variables["SMTG_PLUGIN_IDENTIFIER"] + "|" +
+			       variables["SMTG_PLUGIN_CLASS_NAME"];
+		addUUID (variables, "Processor", name + "|Processor");
+		addUUID (variables, "Controller", name + "|Controller");
+	}
+	else
+	{
+		addUUID (variables, "Processor", makeRandomString ());
+		addUUID (variables, "Controller", makeRandomString ());
+	}
+
+	return variables;
+}
+
+//------------------------------------------------------------------------
+TemplateFile makeTemplateFile (const std::string& relativeInput,
+                               const TemplateVariables& variables)
+{
+	TemplateFile file;
+	file.input = relativeInput;
+	file.output = relativeInput;
+	replaceAll (file.output, "vst3plugin_folder", getVariable (variables, "SMTG_PLUGIN_NAME"));
+	replaceAll (file.output, "SMTG_Processor_UUID",
+	            getVariable (variables, "SMTG_Processor_PLAIN_UUID"));
+	const auto& prefix = getVariable (variables, "SMTG_PREFIX_FOR_FILENAMES");
+	replaceAll (file.output, "vst3plugin", isCMakeOff (prefix) ? std::string () : prefix);
+
+	if (hasTemplateExtension (file.output))
+	{
+		file.configure = true;
+		// the script removes all occurrences, not only the extension
+		replaceAll (file.output, ".in", "");
+	}
+	return file;
+}
+
+//------------------------------------------------------------------------
+Optional<std::string> configureTemplate (const std::string& input,
+                                         const TemplateVariables& variables)
+{
+	auto compiled = CompiledTemplate::compile (input);
+	if (!compiled)
+		return {};
+	return {compiled->render (variables)};
+}
+
+//------------------------------------------------------------------------
+bool generateProject (const TemplateVariables& templateVariables, const GeneratorOptions& options,
+                      std::string& log)
+{
+	const auto& templateDir = getVariable (templateVariables, "SMTG_TEMPLATE_FILES_PATH");
+	const auto& outputDir = getVariable (templateVariables, "SMTG_GENERATOR_OUTPUT_DIRECTORY");
+
+	auto variables = templateVariables;
+	Manifest manifest;
+	std::string manifestPath;
+	if (options.incremental)
+	{
+		manifestPath = outputDir + "/" + getVariable (variables, "SMTG_PLUGIN_NAME") + "/" +
+		               ManifestFileName;
+		if (auto previous = loadManifest (manifestPath))
+		{
+			manifest = std::move (*previous);
+			// deterministic UUIDs are already stable and follow a changed seed
+			if (isCMakeOff (getVariable (variables, "SMTG_DETERMINISTIC_UUIDS")))
+			{
+				for (const auto& uuid : manifest.uuids)
+					variables[uuid.first] = uuid.second;
+			}
+		}
+	}
+
+	log += "-- SMTG_Processor_UUID         : " + getVariable (variables, "SMTG_Processor_UUID") +
+	       "\n";
+	log += "-- SMTG_Controller_UUID        : " +
+	       getVariable (variables, "SMTG_Controller_UUID") + "\n\n";
+
+	auto templates = getCompiledTemplates (templateDir, options.cacheFile);
+	if (!templates)
+	{
+		log += "Could not compile the templates in " + templateDir + "\n";
+		return false;
+	}
+	std::vector<const CompiledTemplateSet::File*> templateFiles;
+	std::vector<TemplateFile> files;
+	files.reserve (templates->files.size ());
+	std::set<std::string> topLevelNames;
+	for (const auto& templateFile : templates->files)
+	{
+		if (!isTemplateUsed (templateFile.path, variables))
+			continue;
+		templateFiles.emplace_back (&templateFile);
+		files.emplace_back (makeTemplateFile (templateFile.path, variables));
+		const auto& output = files.back ().output;
+		topLevelNames.emplace (output.substr (0, output.find ('/')));
+	}
+
+	// a new project is written to a hidden sibling folder which is renamed into place when all
+	// files were written. In an existing project each changed file is written next to its final
+	// path and replaces it at the end. Either way a failure does not leave partial files behind.
+	auto staged = std::none_of (topLevelNames.begin (), topLevelNames.end (),
+	                            [&] (const auto& name) { return pathExists (outputDir + "/" + name); });
+	std::string stagingDir;
+	if (staged)
+		stagingDir = outputDir + "/" + StagingDirectoryPrefix + makeRandomString (8);
+	const auto& writeDir = staged ? stagingDir : outputDir;
+	std::vector<std::string> outputPaths;
+	std::vector<std::string> writePaths;
+	std::set<std::string> directories;
+	for (const auto& file : files)
+	{
+		outputPaths.emplace_back (outputDir + "/" + file.output);
+		writePaths.emplace_back (staged ? writeDir + "/" + file.output
+		                                : outputPaths.back () + TemporaryFileSuffix);
+		auto separator = file.output.find_last_of ('/');
+		directories.emplace (writeDir + "/" + file.output.substr (0, separator == std::string::npos
+		                                                                  ? 0
+		                                                                  : separator));
+	}
+	auto discardWrittenFiles = [&] () {
+		if (staged)
+			removeDirectoryRecursive (stagingDir);
+		else
+		{
+			for (const auto& path : writePaths)
+				removeFile (path);
+		}
+	};
+	// sorted, so the parent directories are created first
+	for (const auto& dir : directories)
+	{
+		if (!createDirectories (dir))
+		{
+			log += "Could not create " + dir + "\n";
+			discardWrittenFiles ();
+			return false;
+		}
+	}
+
+	std::vector<const Manifest::Entry*> previousEntries;
+	for (const auto& file : files)
+	{
+		auto it = manifest.files.find (file.output);
+		previousEntries.emplace_back (it != manifest.files.end () ? &it->second : nullptr);
+	}
+	std::vector<Manifest::Entry> entries (files.size ());
+	std::vector<EmitResult> results (files.size (), EmitResult::Failed);
+	std::vector<std::string> errors (files.size ());
+	std::atomic<bool> failed {false};
+	parallelFor (files.size (), [&] (size_t index) {
+		if (failed)
+			return;
+		results[index] = emitFile (*templateFiles[index], files[index], variables, options,
+		                           templateDir + "/" + files[index].input, outputPaths[index],
+		                           writePaths[index], previousEntries[index], entries[index],
+		                           errors[index]);
+		if (results[index] == EmitResult::Failed)
+			failed = true;
+	});
+
+	auto numWritten = std::count (results.begin (), results.end (), EmitResult::Written);
+	// one sync for all files instead of one per file, before the renames make them visible
+	if (!failed && numWritten > 0 && !syncFileSystem (writeDir))
+	{
+		log += "Could not sync " + writeDir + "\n";
+		failed = true;
+	}
+	if (failed)
+	{
+		for (const auto& error : errors)
+		{
+			if (!error.empty ())
+				log += error + "\n";
+		}
+		discardWrittenFiles ();
+		return false;
+	}
+	if (staged)
+	{
+		for (const auto& name : topLevelNames)
+		{
+			auto stagedPath = stagingDir + "/" + name;
+			auto outputPath = outputDir + "/" + name;
+			// another process may have created the folder in the meantime, then the staged files
+			// are moved into it one by one
+			if (!pathExists (outputPath) && renamePath (stagedPath, outputPath))
+				continue;
+			std::set<std::string> changedDirectories;
+			for (size_t i = 0; i < files.size (); ++i)
+			{
+				if (results[i] != EmitResult::Written || files[i].output.compare (0, name.size () + 1,
+				                                                                  name + "/") != 0)
+					continue;
+				auto dir = outputPaths[i].substr (0, outputPaths[i].find_last_of ('/'));
+				if (!createDirectories (dir) || !renamePath (writePaths[i], outputPaths[i]))
+				{
+					log += "Could not move " + writePaths[i] + " to " + outputPaths[i] + "\n";
+					discardWrittenFiles ();
+					return false;
+				}
+				changedDirectories.emplace (dir);
+			}
+			for (const auto& dir : changedDirectories)
+				syncDirectory (dir);
+		}
+		removeDirectoryRecursive (stagingDir);
+		syncDirectory (outputDir);
+	}
+	else
+	{
+		std::set<std::string> changedDirectories;
+		for (size_t i = 0; i < files.size (); ++i)
+		{
+			if (results[i] != EmitResult::Written)
+				continue;
+			if (!renamePath (writePaths[i], outputPaths[i]))
+			{
+				log += "Could not replace " + outputPaths[i] + "\n";
+				discardWrittenFiles ();
+				return false;
+			}
+			changedDirectories.emplace (
+			    outputPaths[i].substr (0, outputPaths[i].find_last_of ('/')));
+		}
+		for (const auto& dir : changedDirectories)
+			syncDirectory (dir);
+	}
+	if (options.linkCopiedFiles)
+	{
+		for (size_t i = 0; i < files.size (); ++i)
+		{
+			if (!files[i].configure && results[i] == EmitResult::Written)
+				CopiedFiles::instance ().add (entries[i].hash, outputPaths[i],
+				                              entries[i].identity);
+		}
+	}
+
+	size_t numConfigured = 0;
+	size_t numCopied = 0;
+	std::string unchangedFiles;
+	size_t numUnchanged = 0;
+	for (size_t i = 0; i < files.size (); ++i)
+	{
+		if (results[i] == EmitResult::Unchanged)
+		{
+			unchangedFiles += (numUnchanged++ ? ", " : "") + files[i].output;
+		}
+		else if (results[i] == EmitResult::Written)
+			++(files[i].configure ? numConfigured : numCopied);
+	}
+	log += "-- Generated " + std::to_string (files.size ()) + " files in " + outputDir + ": " +
+	       std::to_string (numConfigured) + " configured, " + std::to_string (numCopied) +
+	       " copied, " + std::to_string (numUnchanged) + " unchanged\n";
+	if (numUnchanged > 0)
+		log += "-- Unchanged: " + unchangedFiles + "\n";
+
+	if (options.incremental)
+	{
+		manifest.uuids.clear ();
+		for (const auto& variable : variables)
+		{
+			if (isUUIDVariable (variable.first))
+				manifest.uuids.insert (variable);
+		}
+		// files which are not generated anymore are kept in the manifest
+		for (size_t i = 0; i < files.size (); ++i)
+			manifest.files[files[i].output] = std::move (entries[i]);
+		if (!storeManifest (manifestPath, manifest))
+			log += "Could not write " + manifestPath + "\n";
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
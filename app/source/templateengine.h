@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include "templatecache.h"
+#include "vstgui/lib/optional.h"
+#include <string>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** the -D definitions passed to GenerateVST3Plugin.cmake, e.g. {"SMTG_PLUGIN_NAME_CLI",
+ *  "\"MyPlugin\""} */
+using GeneratorDefinitions = std::vector<std::pair<std::string, std::string>>;
+
+//------------------------------------------------------------------------
+struct TemplateFile
+{
+	/** relative to the template folder */
+	std::string input;
+	/** relative to the output folder */
+	std::string output;
+	/** configure_file (@ONLY LF) for ".in" files, otherwise the file is copied */
+	bool configure {false};
+};
+
+//------------------------------------------------------------------------
+struct GeneratorOptions
+{
+	/** the cache of the compiled templates, may be empty */
+	std::string cacheFile;
+	/** keeps a manifest of the generated files in the project folder. Files whose content did
+	 *  not change since the last generation are not touched and the UUIDs of the last generation
+	 *  are reused */
+	bool incremental {false};
+	/** copied template files with the same content become hard links to the first copy this
+	 *  process wrote, e.g. when several projects are generated. Editing such a file changes it in
+	 *  all projects */
+	bool linkCopiedFiles {false};
+};
+
+//------------------------------------------------------------------------
+/** the variables the script and its modules define for the templates. scriptDir is the folder
+ *  containing GenerateVST3Plugin.cmake */
+TemplateVariables makeTemplateVariables (const GeneratorDefinitions& definitions,
+                                         const std::string& scriptDir);
+
+/** applies the renaming rules of the script to a file in the template folder */
+TemplateFile makeTemplateFile (const std::string& relativeInput,
+                               const TemplateVariables& variables);
+
+/** the same as configure_file (... @ONLY LF). Returns nothing if the input uses #cmakedefine,
+ *  which is not supported. Use CompiledTemplate to configure a template more than once */
+VSTGUI::Optional<std::string> configureTemplate (const std::string& input,
+                                                 const TemplateVariables& variables);
+
+/** Native implementation of GenerateVST3Plugin.cmake.
+ *
+ *	Generates all files of SMTG_TEMPLATE_FILES_PATH into SMTG_GENERATOR_OUTPUT_DIRECTORY with the
+ *	same renaming rules and configure_file semantics as the script, but without starting a CMake
+ *	process. The templates are compiled once and cached.
+ *
+ *	The output directories are created up front, then the files are rendered and written on a
+ *	number of threads. A summary and the errors are appended to log.
+ */
+bool generateProject (const TemplateVariables& variables, const GeneratorOptions& options,
+                      std::string& log);
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#include "uuid.h"
+#include "sha1.h"
+#include <random>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+namespace {
+
+//------------------------------------------------------------------------
+int hexDigitValue (char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+std::string makeSHA1UUID (const std::string& nameSpace, const std::string& name)
+{
+	static constexpr auto hexDigits = "0123456789ABCDEF";
+	static constexpr size_t groupEnds[] = {4, 6, 8, 10, 16};
+
+	if (nameSpace.size () != 36)
+		return {};
+	std::vector<uint8_t> bytes;
+	for (size_t i = 0; i < nameSpace.size (); i += 2)
+	{
+		if (i == 8 || i == 13 || i == 18 || i == 23)
+		{
+			if (nameSpace[i] != '-')
+				return {};
+			++i;
+		}
+		auto high = hexDigitValue (nameSpace[i]);
+		auto low = hexDigitValue (nameSpace[i + 1]);
+		if (high < 0 || low < 0)
+			return {};
+		bytes.emplace_back (static_cast<uint8_t> ((high << 4) | low));
+	}
+
+	SHA1 sha1;
+	sha1.update (bytes.data (), bytes.size ());
+	sha1.update (name);
+	auto digest = sha1.finish ();
+	digest[6] = (digest[6] & 0x0F) | 0x50;
+	digest[8] = (digest[8] & 0x3F) | 0x80;
+
+	std::string result;
+	size_t group = 0;
+	for (size_t i = 0; i < 16; ++i)
+	{
+		if (i == groupEnds[group])
+		{
+			result += '-';
+			++group;
+		}
+		result += hexDigits[digest[i] >> 4];
+		result += hexDigits[digest[i] & 0x0F];
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+std::string makeRandomString (size_t length)
+{
+	static constexpr char alphabet[] =
+	    "qwertyuiopasdfghjklzxcvbnmQWERTYUIOPASDFGHJKLZXCVBNM0123456789";
+
+	std::random_device device;
+	std::mt19937 generator (device ());
+	std::uniform_int_distribution<size_t> distribution (0, sizeof (alphabet) - 2);
+	std::string result;
+	result.reserve (length);
+	for (size_t i = 0; i < length; ++i)
+		result += alphabet[distribution (generator)];
+	return result;
+}
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
@@ -0,0 +1,26 @@
+//------------------------------------------------------------------------
+// Flags       : clang-format SMTGSequencer
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+//------------------------------------------------------------------------
+namespace Steinberg {
+namespace Vst {
+namespace ProjectCreator {
+
+//------------------------------------------------------------------------
+/** name based version 5 UUID, the same as
+ *  string(UUID <out> NAMESPACE <nameSpace> NAME <name> TYPE SHA1 UPPER) of CMake.
+ *  Returns an empty string if nameSpace is not a valid UUID */
+std::string makeSHA1UUID (const std::string& nameSpace, const std::string& name);
+
+/** random alphanumeric string, the same as string(RANDOM LENGTH <length> <out>) of CMake */
+std::string makeRandomString (size_t length = 5);
+
+//------------------------------------------------------------------------
+} // ProjectCreator
+} // Vst
+} // Steinberg
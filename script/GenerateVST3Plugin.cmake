@@ -30,7 +30,28 @@ file(GLOB_RECURSE
     ${SMTG_TEMPLATE_FILES_PATH}/*
 )
 
+set(SMTG_GENERATOR_VERBOSE OFF)
+if(SMTG_GENERATOR_VERBOSE_CLI)
+    set(SMTG_GENERATOR_VERBOSE ${SMTG_GENERATOR_VERBOSE_CLI})
+endif(SMTG_GENERATOR_VERBOSE_CLI)
+
+# A new project is generated into a hidden folder next to it, which is renamed into place at the
+# end. A failure then does not leave a partial project behind.
+set(write_directory ${SMTG_GENERATOR_OUTPUT_DIRECTORY})
+if(NOT EXISTS "${SMTG_GENERATOR_OUTPUT_DIRECTORY}/${SMTG_PLUGIN_NAME}")
+    string(RANDOM LENGTH 8 staging_suffix)
+    set(write_directory "${SMTG_GENERATOR_OUTPUT_DIRECTORY}/.project_generator_staging_${staging_suffix}")
+endif()
+
+set(num_configured_files 0)
+set(num_copied_files 0)
+
 foreach(rel_input_file ${template_files})
+    # The files of the shared SDK build are only generated for projects which use it
+    if(NOT SMTG_VST3_SDK_PREBUILT_CACHE AND rel_input_file MATCHES "^vst3plugin_folder/cmake/")
+        continue()
+    endif()
+
     # Set the plug-in folder name which should be the plug-in's name
     string(REPLACE
         "vst3plugin_folder"
@@ -86,7 +107,7 @@ foreach(rel_input_file ${template_files})
     
     # Create absolute paths from relative paths
     set(abs_input_file ${SMTG_TEMPLATE_FILES_PATH}/${rel_input_file})
-    set(abs_output_file ${SMTG_GENERATOR_OUTPUT_DIRECTORY}/${rel_output_file})
+    set(abs_output_file ${write_directory}/${rel_output_file})
 
     if(DO_CONFIGURE_FILE)
         # Configure and Write file to HD
@@ -96,7 +117,10 @@ foreach(rel_input_file ${template_files})
             @ONLY
             LF
         )
-        message(STATUS "Configured: ${abs_output_file}")
+        math(EXPR num_configured_files "${num_configured_files} + 1")
+        if(SMTG_GENERATOR_VERBOSE)
+            message(STATUS "Configured: ${SMTG_GENERATOR_OUTPUT_DIRECTORY}/${rel_output_file}")
+        endif()
     else()
         # otherwise do a simple copy
         configure_file(
@@ -104,7 +128,21 @@ foreach(rel_input_file ${template_files})
             ${abs_output_file}
             COPYONLY
         )
-        message(STATUS "Copied    : ${abs_output_file}")
+        math(EXPR num_copied_files "${num_copied_files} + 1")
+        if(SMTG_GENERATOR_VERBOSE)
+            message(STATUS "Copied    : ${SMTG_GENERATOR_OUTPUT_DIRECTORY}/${rel_output_file}")
+        endif()
     endif()
 
 endforeach()
+
+if(NOT write_directory STREQUAL SMTG_GENERATOR_OUTPUT_DIRECTORY)
+    file(RENAME
+        "${write_directory}/${SMTG_PLUGIN_NAME}"
+        "${SMTG_GENERATOR_OUTPUT_DIRECTORY}/${SMTG_PLUGIN_NAME}"
+    )
+    file(REMOVE_RECURSE "${write_directory}")
+endif()
+
+list(LENGTH template_files num_template_files)
+message(STATUS "Generated ${num_template_files} files in ${SMTG_GENERATOR_OUTPUT_DIRECTORY}: ${num_configured_files} configured, ${num_copied_files} copied")
@@ -33,3 +33,23 @@ else()
         return nullptr;"
     )
 endif(SMTG_ENABLE_VSTGUI_SUPPORT)
+
+# The build options snippets and the header list are shared with the native generator of the app
+set(SMTG_CODE_SNIPPETS_PATH ${SMTG_CMAKE_SCRIPT_DIR}/cmake/snippets)
+set(SMTG_TARGET_BUILD_OPTIONS_CODE_SNIPPET "")
+if(SMTG_ENABLE_PRECOMPILED_HEADERS)
+    file(STRINGS ${SMTG_CODE_SNIPPETS_PATH}/precompiled_headers.txt SMTG_PRECOMPILED_HEADERS)
+    if(SMTG_ENABLE_VSTGUI_SUPPORT)
+        file(STRINGS ${SMTG_CODE_SNIPPETS_PATH}/precompiled_headers_vstgui.txt vstgui_headers)
+        list(APPEND SMTG_PRECOMPILED_HEADERS ${vstgui_headers})
+    endif(SMTG_ENABLE_VSTGUI_SUPPORT)
+    string(REPLACE ";" "\n            " SMTG_PRECOMPILED_HEADERS "${SMTG_PRECOMPILED_HEADERS}")
+    file(READ ${SMTG_CODE_SNIPPETS_PATH}/precompiled_headers.cmake.in snippet)
+    string(CONFIGURE "${snippet}" snippet @ONLY)
+    string(APPEND SMTG_TARGET_BUILD_OPTIONS_CODE_SNIPPET "${snippet}")
+endif(SMTG_ENABLE_PRECOMPILED_HEADERS)
+if(SMTG_ENABLE_UNITY_BUILD)
+    file(READ ${SMTG_CODE_SNIPPETS_PATH}/unity_build.cmake.in snippet)
+    string(CONFIGURE "${snippet}" snippet @ONLY)
+    string(APPEND SMTG_TARGET_BUILD_OPTIONS_CODE_SNIPPET "${snippet}")
+endif(SMTG_ENABLE_UNITY_BUILD)
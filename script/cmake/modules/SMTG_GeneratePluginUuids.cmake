@@ -2,9 +2,32 @@ cmake_minimum_required(VERSION 3.14.0)
 
 include(SMTG_GenerateUuid)
 
+# Deterministic UUIDs are derived from the seed if there is one, otherwise from the vendor name,
+# the plug-in identifier and the class name. The same inputs then generate the same files.
+set(SMTG_DETERMINISTIC_UUIDS OFF)
+if(SMTG_DETERMINISTIC_UUIDS_CLI)
+    set(SMTG_DETERMINISTIC_UUIDS ${SMTG_DETERMINISTIC_UUIDS_CLI})
+endif(SMTG_DETERMINISTIC_UUIDS_CLI)
+
+set(SMTG_UUID_SEED "")
+if(SMTG_UUID_SEED_CLI)
+    string(REPLACE "\"" "" SMTG_UUID_SEED ${SMTG_UUID_SEED_CLI})
+    set(SMTG_DETERMINISTIC_UUIDS ON)
+endif(SMTG_UUID_SEED_CLI)
+
 macro(smtg_generate_plugin_uuids)
-    smtg_generate_uuid(Processor)   # -> SMTG_Processor_UUID
-    smtg_generate_uuid(Controller)  # -> SMTG_Controller_UUID
+    if(SMTG_DETERMINISTIC_UUIDS)
+        if(SMTG_UUID_SEED)
+            set(SMTG_UUID_NAME "${SMTG_UUID_SEED}")
+        else()
+            set(SMTG_UUID_NAME "${SMTG_VENDOR_NAME}|${SMTG_PLUGIN_IDENTIFIER}|${SMTG_PLUGIN_CLASS_NAME}")
+        endif()
+        smtg_generate_name_based_uuid(Processor "${SMTG_UUID_NAME}|Processor")
+        smtg_generate_name_based_uuid(Controller "${SMTG_UUID_NAME}|Controller")
+    else()
+        smtg_generate_uuid(Processor)   # -> SMTG_Processor_UUID
+        smtg_generate_uuid(Controller)  # -> SMTG_Controller_UUID
+    endif()
 endmacro(smtg_generate_plugin_uuids)
 
 macro(smtg_print_plugin_uuids)
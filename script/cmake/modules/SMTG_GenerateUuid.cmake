@@ -10,15 +10,14 @@ macro(smtg_make_uuid SHA1_UUID PREFIX)
     set(SMTG_${PREFIX}_PLAIN_UUID "${SMTG_${PREFIX}_UUID_PART_0}${SMTG_${PREFIX}_UUID_PART_1}${SMTG_${PREFIX}_UUID_PART_2}${SMTG_${PREFIX}_UUID_PART_3}")
 endmacro(smtg_make_uuid)
 
-macro(smtg_generate_uuid PREFIX)
-    string(RANDOM SMTG_RAND_NUMBER)
-
+# The same name always results in the same UUID
+macro(smtg_generate_name_based_uuid PREFIX UUID_NAME)
     # UUID DNS namespace generated at Steinberg
     set(UUID_DNS_NAMESPACE ed66da11-5014-4e8a-876d-829007337274)
     string(
         UUID SHA1_UUID
         NAMESPACE ${UUID_DNS_NAMESPACE}
-        NAME ${SMTG_RAND_NUMBER}
+        NAME "${UUID_NAME}"
         TYPE SHA1 UPPER
     )
 
@@ -30,4 +29,9 @@ macro(smtg_generate_uuid PREFIX)
         ${SHA1_UUID}
     )
     smtg_make_uuid(${SHA1_UUID} ${PREFIX})
+endmacro(smtg_generate_name_based_uuid)
+
+macro(smtg_generate_uuid PREFIX)
+    string(RANDOM SMTG_RAND_NUMBER)
+    smtg_generate_name_based_uuid(${PREFIX} ${SMTG_RAND_NUMBER})
 endmacro(smtg_generate_uuid)
@@ -22,10 +22,41 @@ if(SMTG_ENABLE_VSTGUI_SUPPORT_CLI)
     set(SMTG_ENABLE_VSTGUI_SUPPORT ${SMTG_ENABLE_VSTGUI_SUPPORT_CLI})
 endif(SMTG_ENABLE_VSTGUI_SUPPORT_CLI)
 
+# Build options of the plug-in target, they need CMake 3.16 when the project is configured
+set(SMTG_ENABLE_PRECOMPILED_HEADERS OFF)
+if(SMTG_ENABLE_PRECOMPILED_HEADERS_CLI)
+    set(SMTG_ENABLE_PRECOMPILED_HEADERS ${SMTG_ENABLE_PRECOMPILED_HEADERS_CLI})
+endif(SMTG_ENABLE_PRECOMPILED_HEADERS_CLI)
+set(SMTG_ENABLE_UNITY_BUILD OFF)
+if(SMTG_ENABLE_UNITY_BUILD_CLI)
+    set(SMTG_ENABLE_UNITY_BUILD ${SMTG_ENABLE_UNITY_BUILD_CLI})
+endif(SMTG_ENABLE_UNITY_BUILD_CLI)
+
+# Folder of the VST 3 SDK builds shared by the generated projects, empty to build the SDK in each
+# project
+set(SMTG_VST3_SDK_PREBUILT_CACHE "")
+if(SMTG_VST3_SDK_PREBUILT_CACHE_CLI)
+    string(REPLACE "\"" "" SMTG_VST3_SDK_PREBUILT_CACHE ${SMTG_VST3_SDK_PREBUILT_CACHE_CLI})
+endif(SMTG_VST3_SDK_PREBUILT_CACHE_CLI)
+
+# Compiler cache (ccache or sccache) used by the generated project, empty to use none
+set(SMTG_COMPILER_LAUNCHER "")
+if(SMTG_COMPILER_LAUNCHER_CLI)
+    string(REPLACE "\"" "" SMTG_COMPILER_LAUNCHER ${SMTG_COMPILER_LAUNCHER_CLI})
+endif(SMTG_COMPILER_LAUNCHER_CLI)
+
 function(smtg_print_generator_specifics)
     message(STATUS "SMTG_ENABLE_VSTGUI_SUPPORT      : ${SMTG_ENABLE_VSTGUI_SUPPORT}")
     message(STATUS "SMTG_GENERATOR_OUTPUT_DIRECTORY : ${SMTG_GENERATOR_OUTPUT_DIRECTORY}")
     message(STATUS "SMTG_TEMPLATE_FILES_PATH        : ${SMTG_TEMPLATE_FILES_PATH}")
     message(STATUS "SMTG_VST3_SDK_SOURCE_DIR        : ${SMTG_VST3_SDK_SOURCE_DIR}")
+    message(STATUS "SMTG_ENABLE_PRECOMPILED_HEADERS : ${SMTG_ENABLE_PRECOMPILED_HEADERS}")
+    message(STATUS "SMTG_ENABLE_UNITY_BUILD         : ${SMTG_ENABLE_UNITY_BUILD}")
+    if(SMTG_VST3_SDK_PREBUILT_CACHE)
+        message(STATUS "SMTG_VST3_SDK_PREBUILT_CACHE    : ${SMTG_VST3_SDK_PREBUILT_CACHE}")
+    endif()
+    if(SMTG_COMPILER_LAUNCHER)
+        message(STATUS "SMTG_COMPILER_LAUNCHER          : ${SMTG_COMPILER_LAUNCHER}")
+    endif()
     message("")
 endfunction(smtg_print_generator_specifics)
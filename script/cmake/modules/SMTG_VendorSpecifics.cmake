@@ -14,7 +14,7 @@ set(SMTG_PLUGIN_CLASS_NAME "MyPlugin")
 set(SMTG_PREFIX_FOR_FILENAMES "")
 set(SMTG_PLUGIN_BUNDLE_NAME "MyPlugin")
 set(SMTG_PLUGIN_CATEGORY "Fx")
-set(SMTG_MACOS_DEPLOYMENT_TARGET "10.12")
+set(SMTG_MACOS_DEPLOYMENT_TARGET "10.13")
 
 # Replace by command line arguments
 if(SMTG_VENDOR_NAME_CLI)
@@ -0,0 +1,173 @@
+cmake_minimum_required(VERSION 3.14.0)
+
+# Builds the libraries of the VST 3 SDK once in a folder shared by all projects and imports them
+# instead of building them in every project. There is one build per SDK version, generator,
+# compiler and configuration.
+
+set(SMTG_PREBUILT_VST3SDK_MODULE_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+# Sets <OUT_VAR> to the SDK version and, for a git checkout, to its revision.
+function(smtg_get_prebuilt_vst3_sdk_revision OUT_VAR)
+    set(revision "")
+    if(EXISTS "${vst3sdk_SOURCE_DIR}/pluginterfaces/vst/vsttypes.h")
+        file(STRINGS "${vst3sdk_SOURCE_DIR}/pluginterfaces/vst/vsttypes.h" version
+            REGEX "kVstVersionString"
+        )
+        list(APPEND revision "${version}")
+    endif()
+    if(EXISTS "${vst3sdk_SOURCE_DIR}/.git")
+        find_package(Git QUIET)
+        if(GIT_FOUND)
+            execute_process(
+                COMMAND "${GIT_EXECUTABLE}" rev-parse HEAD
+                WORKING_DIRECTORY "${vst3sdk_SOURCE_DIR}"
+                OUTPUT_VARIABLE git_revision
+                OUTPUT_STRIP_TRAILING_WHITESPACE
+                ERROR_QUIET
+            )
+            list(APPEND revision "${git_revision}")
+        endif()
+    endif()
+    set(${OUT_VAR} "${revision}" PARENT_SCOPE)
+endfunction(smtg_get_prebuilt_vst3_sdk_revision)
+
+# Builds the SDK for this project's toolchain. The build folder is configured once and then
+# built incrementally, so it is quickly up to date if the SDK sources did not change.
+# <OUT_DIR> is set to the build folder, or to an empty string if the build failed.
+function(smtg_build_prebuilt_vst3_sdk CACHE_DIR OUT_DIR)
+    set(${OUT_DIR} "" PARENT_SCOPE)
+
+    smtg_get_prebuilt_vst3_sdk_revision(sdk_revision)
+    set(toolchain
+        "${vst3sdk_SOURCE_DIR}"
+        "${sdk_revision}"
+        "${SMTG_ENABLE_VSTGUI_SUPPORT}"
+        "${CMAKE_GENERATOR}"
+        "${CMAKE_GENERATOR_PLATFORM}"
+        "${CMAKE_GENERATOR_TOOLSET}"
+        "${CMAKE_TOOLCHAIN_FILE}"
+        "${CMAKE_C_COMPILER}"
+        "${CMAKE_CXX_COMPILER}"
+        "${CMAKE_CXX_COMPILER_VERSION}"
+        "${CMAKE_BUILD_TYPE}"
+        "${CMAKE_CONFIGURATION_TYPES}"
+        "${CMAKE_OSX_DEPLOYMENT_TARGET}"
+        "${CMAKE_OSX_ARCHITECTURES}"
+    )
+    string(SHA1 key "${toolchain}")
+    string(SUBSTRING ${key} 0 16 key)
+    set(prebuilt_dir "${CACHE_DIR}/${key}")
+
+    # Other projects may build the same SDK at the same time
+    file(MAKE_DIRECTORY "${prebuilt_dir}")
+    file(LOCK "${prebuilt_dir}.lock" GUARD FUNCTION TIMEOUT 3600 RESULT_VARIABLE lock_result)
+    if(lock_result)
+        message(WARNING "Could not lock the shared VST 3 SDK build ${prebuilt_dir}: ${lock_result}")
+        return()
+    endif()
+
+    if(NOT EXISTS "${prebuilt_dir}/configure.stamp")
+        message(STATUS "Configuring the shared VST 3 SDK in ${prebuilt_dir}")
+
+        # The toolchain of this project is passed with an initial cache, so lists keep their
+        # semicolons and paths need no escaping
+        set(initial_cache "")
+        foreach(var
+            CMAKE_BUILD_TYPE
+            CMAKE_CONFIGURATION_TYPES
+            CMAKE_TOOLCHAIN_FILE
+            CMAKE_C_COMPILER
+            CMAKE_CXX_COMPILER
+            CMAKE_C_COMPILER_LAUNCHER
+            CMAKE_CXX_COMPILER_LAUNCHER
+            CMAKE_OBJC_COMPILER_LAUNCHER
+            CMAKE_OBJCXX_COMPILER_LAUNCHER
+            CMAKE_OSX_DEPLOYMENT_TARGET
+            CMAKE_OSX_ARCHITECTURES
+            SMTG_ENABLE_VSTGUI_SUPPORT
+        )
+            if(DEFINED ${var})
+                string(APPEND initial_cache "set(${var} [==[${${var}}]==] CACHE STRING \"\")\n")
+            endif()
+        endforeach()
+        string(APPEND initial_cache "set(vst3sdk_SOURCE_DIR [==[${vst3sdk_SOURCE_DIR}]==] CACHE PATH \"\")\n")
+        string(APPEND initial_cache "set(SMTG_ENABLE_VST3_PLUGIN_EXAMPLES OFF CACHE BOOL \"\")\n")
+        string(APPEND initial_cache "set(SMTG_ENABLE_VST3_HOSTING_EXAMPLES OFF CACHE BOOL \"\")\n")
+        file(WRITE "${prebuilt_dir}/initial_cache.cmake" "${initial_cache}")
+
+        # A copy of the sources, so the build does not depend on this project
+        configure_file(
+            "${SMTG_PREBUILT_VST3SDK_MODULE_DIR}/prebuilt_vst3sdk/CMakeLists.txt"
+            "${prebuilt_dir}/source/CMakeLists.txt"
+            COPYONLY
+        )
+
+        set(configure_command
+            ${CMAKE_COMMAND}
+            -C "${prebuilt_dir}/initial_cache.cmake"
+            -S "${prebuilt_dir}/source"
+            -B "${prebuilt_dir}/build"
+            -G "${CMAKE_GENERATOR}"
+        )
+        if(CMAKE_GENERATOR_PLATFORM)
+            list(APPEND configure_command -A "${CMAKE_GENERATOR_PLATFORM}")
+        endif()
+        if(CMAKE_GENERATOR_TOOLSET)
+            list(APPEND configure_command -T "${CMAKE_GENERATOR_TOOLSET}")
+        endif()
+        execute_process(
+            COMMAND ${configure_command}
+            RESULT_VARIABLE result
+            OUTPUT_FILE "${prebuilt_dir}/configure.log"
+            ERROR_FILE "${prebuilt_dir}/configure.log"
+        )
+        if(result)
+            message(WARNING "Could not configure the shared VST 3 SDK, see ${prebuilt_dir}/configure.log")
+            return()
+        endif()
+        file(WRITE "${prebuilt_dir}/configure.stamp" "${toolchain}")
+    endif()
+
+    # Always built while the lock is held, local changes of the SDK sources are not part of the key
+    message(STATUS "Building the shared VST 3 SDK in ${prebuilt_dir}")
+    # Single configuration generators build once, with the build type of the cache
+    set(configs ${CMAKE_CONFIGURATION_TYPES})
+    if(NOT configs)
+        set(configs default)
+    endif()
+    foreach(config ${configs})
+        set(build_command ${CMAKE_COMMAND} --build "${prebuilt_dir}/build" --target smtg_prebuilt_vst3sdk_targets)
+        if(CMAKE_CONFIGURATION_TYPES)
+            list(APPEND build_command --config ${config})
+        endif()
+        execute_process(
+            COMMAND ${build_command}
+            RESULT_VARIABLE result
+            OUTPUT_FILE "${prebuilt_dir}/build_${config}.log"
+            ERROR_FILE "${prebuilt_dir}/build_${config}.log"
+        )
+        if(result)
+            message(WARNING "Could not build the shared VST 3 SDK, see ${prebuilt_dir}/build_${config}.log")
+            return()
+        endif()
+    endforeach()
+
+    set(${OUT_DIR} "${prebuilt_dir}/build" PARENT_SCOPE)
+endfunction(smtg_build_prebuilt_vst3_sdk)
+
+# Imports the shared SDK libraries, <RESULT> is set to FALSE if they are not available and the
+# SDK needs to be added with add_subdirectory.
+macro(smtg_use_prebuilt_vst3_sdk CACHE_DIR RESULT)
+    smtg_build_prebuilt_vst3_sdk("${CACHE_DIR}" smtg_prebuilt_vst3sdk_dir)
+    if(smtg_prebuilt_vst3sdk_dir)
+        message(STATUS "Using the shared VST 3 SDK in ${smtg_prebuilt_vst3sdk_dir}")
+        list(APPEND CMAKE_MODULE_PATH "${vst3sdk_SOURCE_DIR}/cmake/modules")
+        include(SMTG_VST3_SDK)
+        include("${smtg_prebuilt_vst3sdk_dir}/vst3sdk-targets.cmake")
+        # The SDK sets these for its own folder only
+        include_directories("${vst3sdk_SOURCE_DIR}")
+        set(${RESULT} TRUE)
+    else()
+        set(${RESULT} FALSE)
+    endif()
+endmacro(smtg_use_prebuilt_vst3_sdk)